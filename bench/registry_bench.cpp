@@ -0,0 +1,103 @@
+// Registration and dispatch cost of one million trivial tests.
+//
+// Compares the Registry against the layout it replaced, where every entry held a
+// std::function wrapping the test lifecycle. Both sides run the same lifecycle
+// (RunTestMethod), so the difference is the cost of storing and calling the body.
+//
+//     cmake -S . -B build -DFLUL_BENCH=ON && cmake --build build --target registry_bench
+//     ./build/registry_bench [tests]
+
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <print>
+#include <string_view>
+#include <vector>
+
+#include "flul/test/registry.hpp"
+#include "flul/test/suite.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+class TrivialSuite : public flul::test::Suite<TrivialSuite> {
+   public:
+    void Test() {  // NOLINT(readability-convert-member-functions-to-static)
+        ++runs_;
+    }
+
+    static std::size_t runs_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+};
+
+std::size_t TrivialSuite::runs_ = 0;
+
+struct FunctionEntry {
+    std::string_view suite_name;
+    std::string_view test_name;
+    std::function<void()> callable;
+};
+
+auto Millis(Clock::duration d) -> double {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+void Report(std::string_view name, std::size_t count, Clock::duration add,
+            Clock::duration run) {
+    auto per = [count](Clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() / static_cast<double>(count);
+    };
+    std::println("{:<14} register {:8.1f} ms ({:5.1f} ns/test)  dispatch {:8.1f} ms "
+                 "({:5.1f} ns/test)",
+                 name, Millis(add), per(add), Millis(run), per(run));
+}
+
+void BenchFunction(std::size_t count) {
+    auto start = Clock::now();
+    std::vector<FunctionEntry> entries;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto method = &TrivialSuite::Test;
+        entries.push_back({.suite_name = "TrivialSuite",
+                           .test_name = "Test",
+                           .callable = [method] {
+                               flul::test::RunTestMethod<TrivialSuite>(method);
+                           }});
+    }
+    auto added = Clock::now();
+    for (const auto& entry : entries) {
+        entry.callable();
+    }
+    Report("std::function", count, added - start, Clock::now() - added);
+}
+
+void BenchRegistry(std::size_t count) {
+    auto start = Clock::now();
+    flul::test::Registry registry;
+    for (std::size_t i = 0; i < count; ++i) {
+        registry.Add<TrivialSuite>("TrivialSuite", "Test", &TrivialSuite::Test);
+    }
+    auto added = Clock::now();
+    for (const auto& entry : registry.Tests()) {
+        entry.callable();
+    }
+    Report("Registry", count, added - start, Clock::now() - added);
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    std::size_t count = 1'000'000;
+    if (argc > 1) {
+        std::string_view arg(argv[1]);
+        std::from_chars(arg.data(), arg.data() + arg.size(), count);
+    }
+
+    BenchFunction(count);
+    BenchRegistry(count);
+    if (TrivialSuite::runs_ != 2 * count) {
+        std::println(stderr, "error: ran {} tests, expected {}", TrivialSuite::runs_, 2 * count);
+        return 1;
+    }
+    return 0;
+}
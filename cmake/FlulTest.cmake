@@ -1,12 +1,28 @@
+# flul_test_discover(<target> [MANIFEST])
+#
+# Registers every test of <target> with CTest after each link. By default the binary is
+# run with --list. With MANIFEST the tests are read from the flul_manifest section that
+# FLUL_TEST_MANIFEST tables are linked into, so the binary is never executed; only tests
+# recorded in the manifest are registered.
 function(flul_test_discover TARGET)
+    cmake_parse_arguments(PARSE_ARGV 1 arg "MANIFEST" "" "")
     set(ctest_file "${CMAKE_CURRENT_BINARY_DIR}/${TARGET}_tests.cmake")
 
+    set(manifest_args "")
+    if(arg_MANIFEST)
+        if(NOT CMAKE_OBJCOPY)
+            message(FATAL_ERROR "flul_test_discover(${TARGET} MANIFEST) needs objcopy")
+        endif()
+        set(manifest_args -D "OBJCOPY=${CMAKE_OBJCOPY}")
+    endif()
+
     add_custom_command(
         TARGET ${TARGET} POST_BUILD
         BYPRODUCTS "${ctest_file}"
         COMMAND "${CMAKE_COMMAND}"
             -D "TEST_EXECUTABLE=$<TARGET_FILE:${TARGET}>"
             -D "CTEST_FILE=${ctest_file}"
+            ${manifest_args}
             -P "${PROJECT_SOURCE_DIR}/cmake/FlulTestDiscovery.cmake"
         VERBATIM
     )
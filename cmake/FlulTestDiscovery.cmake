@@ -1,27 +1,71 @@
-execute_process(
-    COMMAND "${TEST_EXECUTABLE}" --list
-    OUTPUT_VARIABLE output
-    OUTPUT_STRIP_TRAILING_WHITESPACE
-    RESULT_VARIABLE result
-)
+# Keep the empty tags field of manifest lines when splitting them into lists.
+cmake_policy(SET CMP0007 NEW)
 
-if(NOT result EQUAL 0)
-    message(FATAL_ERROR
-        "Test discovery failed for '${TEST_EXECUTABLE}' (exit code ${result})")
-endif()
+if(OBJCOPY)
+    # Manifest mode: extract the flul_manifest section instead of running the binary.
+    # Each line is "Suite::Test<TAB>tag,tag<TAB>timeout<TAB>cost".
+    set(manifest_file "${CTEST_FILE}.manifest")
+    file(REMOVE "${manifest_file}")
+    execute_process(
+        COMMAND "${OBJCOPY}" --dump-section "flul_manifest=${manifest_file}"
+            "${TEST_EXECUTABLE}" "${manifest_file}.unused"
+        RESULT_VARIABLE result
+        ERROR_VARIABLE error
+    )
+    file(REMOVE "${manifest_file}.unused")
+    if(NOT result EQUAL 0)
+        message(WARNING
+            "No test manifest in '${TEST_EXECUTABLE}'; no tests registered\n${error}")
+        set(test_list "")
+    else()
+        # Tables recorded in a header are linked in once per translation unit.
+        file(STRINGS "${manifest_file}" test_list)
+        file(REMOVE "${manifest_file}")
+        list(REMOVE_DUPLICATES test_list)
+    endif()
+else()
+    execute_process(
+        COMMAND "${TEST_EXECUTABLE}" --list --with-tags
+        OUTPUT_VARIABLE output
+        OUTPUT_STRIP_TRAILING_WHITESPACE
+        RESULT_VARIABLE result
+    )
 
-if(output STREQUAL "")
-    file(WRITE "${CTEST_FILE}" "")
-    return()
-endif()
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR
+            "Test discovery failed for '${TEST_EXECUTABLE}' (exit code ${result})")
+    endif()
 
-string(REPLACE "\n" ";" test_list "${output}")
+    # Each line is "Suite::Test<TAB>tag,tag".
+    string(REPLACE "\n" ";" test_list "${output}")
+endif()
 
 file(WRITE "${CTEST_FILE}" "")
-foreach(test IN LISTS test_list)
-    if(NOT test STREQUAL "")
+foreach(line IN LISTS test_list)
+    if(line STREQUAL "")
+        continue()
+    endif()
+    # Fields after the name: tags, which become CTest labels, then (manifest only) the
+    # timeout in seconds and the cost hint; 0 leaves a property unset.
+    string(REPLACE "\t" ";" fields "${line}")
+    list(POP_FRONT fields test tags timeout cost)
+    file(APPEND "${CTEST_FILE}"
+        "add_test(\"${test}\" \"${TEST_EXECUTABLE}\" \"--exact\" \"${test}\")\n"
+    )
+    set(properties "")
+    if(NOT "${tags}" STREQUAL "")
+        string(REPLACE "," ";" labels "${tags}")
+        string(APPEND properties " LABELS \"${labels}\"")
+    endif()
+    if("${timeout}" GREATER 0)
+        string(APPEND properties " TIMEOUT ${timeout}")
+    endif()
+    if("${cost}" GREATER 0)
+        string(APPEND properties " COST ${cost}")
+    endif()
+    if(NOT properties STREQUAL "")
         file(APPEND "${CTEST_FILE}"
-            "add_test(\"${test}\" \"${TEST_EXECUTABLE}\" \"--filter\" \"${test}\")\n"
+            "set_tests_properties(\"${test}\" PROPERTIES${properties})\n"
         )
     endif()
 endforeach()
@@ -5,11 +5,16 @@
 #include <format>
 #include <source_location>
 #include <string>
+#include <utility>
 
 namespace flul::test {
 
+// A failed expectation. Throwing one only moves the two strings in; the message is
+// formatted when it is first asked for, so failures that are caught and discarded — by
+// ExpectCallable(...).ToThrow<AssertionError>(), or while shrinking a property — never pay
+// for it.
 class AssertionError : public std::exception {
-    std::string what_;
+    mutable std::string what_;  // Message(), cached by the first what()
 
    public:
     // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes): intentional public
@@ -21,13 +26,26 @@ class AssertionError : public std::exception {
 
     constexpr AssertionError(std::string actual_val, std::string expected_val,
                              std::source_location loc)
-        : what_(std::format("{}:{}: assertion failed\n  expected: {}\n    actual: {}",
-                            loc.file_name(), loc.line(), expected_val, actual_val)),
-          actual(std::move(actual_val)),
-          expected(std::move(expected_val)),
-          location(loc) {}
+        : actual(std::move(actual_val)), expected(std::move(expected_val)), location(loc) {}
+
+    // "file:line: assertion failed", then the expected and actual values on their own
+    // lines. Formats a fresh string on every call; reporters use this and leave the
+    // what() cache empty.
+    [[nodiscard]] auto Message() const -> std::string {
+        return std::format("{}:{}: assertion failed\n  expected: {}\n    actual: {}",
+                           location.file_name(), location.line(), expected, actual);
+    }
 
+    // Message(), formatted on the first call. The cache is not synchronized: like any
+    // exception object, an AssertionError is inspected by one thread at a time.
     [[nodiscard]] auto what() const noexcept -> const char* override {
+        if (what_.empty()) {
+            try {
+                what_ = Message();
+            } catch (...) {
+                return "assertion failed";
+            }
+        }
         return what_.c_str();
     }
 };
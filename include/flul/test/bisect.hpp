@@ -0,0 +1,279 @@
+#ifndef FLUL_TEST_BISECT_HPP_
+#define FLUL_TEST_BISECT_HPP_
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <print>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "flul/test/name_index.hpp"
+#include "flul/test/test_entry.hpp"
+#include "flul/test/work_queue.hpp"
+
+namespace flul::test {
+
+// Finds the tests that make `target` fail when they run before it in the same process.
+//
+// Every probe forks a child that runs a subset of the preceding tests (in registry
+// order, ignoring their own results) followed by the target, and reports whether the
+// target failed. Up to `jobs` probes run at once:
+//
+//  1. A (jobs+1)-ary search over prefixes of the preceding tests finds the shortest
+//     polluting prefix; its last test is necessarily part of the polluting set.
+//  2. If that test does not pollute on its own, a parallel delta debugging pass (all
+//     chunks and complements of a round probed concurrently) minimises the rest of the
+//     prefix, keeping the last test in every probe.
+//
+// A single polluter among N tests thus takes about log_{jobs+1}(N) rounds instead of the
+// log_2(N) serial runs of a bisection or the many more of serial ddmin.
+class PolluterBisection {
+   public:
+    struct Outcome {
+        enum class Kind {
+            kFound,          // `polluters` holds a minimal polluting set
+            kFailsAlone,     // the target fails without anything running before it
+            kNotReproduced,  // the target passes after all preceding tests
+        };
+
+        Kind kind;
+        std::vector<std::size_t> polluters;  // indices into the test span, in order
+        std::size_t probes;
+        std::size_t rounds;
+    };
+
+    PolluterBisection(std::span<const TestEntry> tests, std::size_t target, std::size_t jobs)
+        : tests_(tests), target_(target), jobs_(std::max<std::size_t>(jobs, 1)) {}
+
+    auto Run() -> Outcome {
+        Outcome outcome{.kind = Outcome::Kind::kFound, .polluters = {}, .probes = 0, .rounds = 0};
+
+        std::vector<std::size_t> preceding(target_);
+        for (std::size_t i = 0; i < target_; ++i) {
+            preceding[i] = i;
+        }
+        auto baseline = Probe({{}, preceding}, outcome);
+        if (baseline[0]) {
+            outcome.kind = Outcome::Kind::kFailsAlone;
+            return outcome;
+        }
+        if (!baseline[1]) {
+            outcome.kind = Outcome::Kind::kNotReproduced;
+            return outcome;
+        }
+
+        // Invariant: the prefix of length `lo` is clean, the one of length `hi` pollutes.
+        std::size_t lo = 0;
+        std::size_t hi = target_;
+        while (hi - lo > 1) {
+            auto cuts_count = std::min(jobs_, hi - lo - 1);
+            std::vector<std::size_t> cuts;
+            std::vector<std::vector<std::size_t>> prefixes;
+            for (std::size_t j = 1; j <= cuts_count; ++j) {
+                auto cut = lo + ((hi - lo) * j / (cuts_count + 1));
+                if (cuts.empty() || cut != cuts.back()) {
+                    cuts.push_back(cut);
+                    prefixes.emplace_back(preceding.begin(),
+                                          preceding.begin() + static_cast<std::ptrdiff_t>(cut));
+                }
+            }
+            auto polluted = Probe(prefixes, outcome);
+            for (std::size_t j = 0; j < cuts.size(); ++j) {
+                if (polluted[j]) {
+                    hi = cuts[j];
+                    break;
+                }
+                lo = cuts[j];
+            }
+        }
+
+        auto last = hi - 1;
+        if (Probe({std::vector<std::size_t>{last}}, outcome)[0]) {
+            outcome.polluters = {last};
+            return outcome;
+        }
+
+        auto rest = std::vector<std::size_t>(preceding.begin(),
+                                             preceding.begin() + static_cast<std::ptrdiff_t>(last));
+        outcome.polluters = Minimise(std::move(rest), last, outcome);
+        outcome.polluters.push_back(last);
+        return outcome;
+    }
+
+   private:
+    std::span<const TestEntry> tests_;
+    std::size_t target_;
+    std::size_t jobs_;
+
+    // Delta debugging over `set`, where `set` plus `required` is known to pollute.
+    auto Minimise(std::vector<std::size_t> set, std::size_t required, Outcome& outcome)
+        -> std::vector<std::size_t> {
+        std::size_t n = 2;
+        while (set.size() >= 2) {
+            n = std::min(n, set.size());
+            std::vector<std::vector<std::size_t>> chunks(n);
+            for (std::size_t i = 0; i < set.size(); ++i) {
+                chunks[i * n / set.size()].push_back(set[i]);
+            }
+
+            // With two chunks each complement is the other chunk.
+            std::vector<std::vector<std::size_t>> subsets = chunks;
+            if (n > 2) {
+                for (std::size_t c = 0; c < n; ++c) {
+                    auto& complement = subsets.emplace_back();
+                    for (std::size_t other = 0; other < n; ++other) {
+                        if (other != c) {
+                            complement.insert(complement.end(), chunks[other].begin(),
+                                              chunks[other].end());
+                        }
+                    }
+                    std::ranges::sort(complement);
+                }
+            }
+            for (auto& subset : subsets) {
+                subset.push_back(required);
+            }
+
+            auto polluted = Probe(subsets, outcome);
+            auto hit = std::ranges::find(polluted, true);
+            if (hit == polluted.end()) {
+                if (n == set.size()) {
+                    break;  // every single test is needed
+                }
+                n = std::min(n * 2, set.size());
+                continue;
+            }
+            auto index = static_cast<std::size_t>(hit - polluted.begin());
+            auto& winner = subsets[index];
+            winner.pop_back();
+            set = std::move(winner);
+            n = index < n ? 2 : std::max<std::size_t>(n - 1, 2);
+        }
+        return set;
+    }
+
+    // Runs every subset followed by the target in its own child, `jobs_` at a time, and
+    // returns which of them made the target fail. A child that dies before reaching the
+    // target (a crashing candidate) counts as clean.
+    auto Probe(const std::vector<std::vector<std::size_t>>& subsets, Outcome& outcome)
+        -> std::vector<bool> {
+        using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace)
+
+        SharedArray<std::atomic<std::uint32_t>> reached(subsets.size());
+        std::vector<bool> polluted(subsets.size(), false);
+        std::vector<std::pair<pid_t, std::size_t>> running;
+        std::size_t next = 0;
+
+        ++outcome.rounds;
+        outcome.probes += subsets.size();
+        while (next < subsets.size() || !running.empty()) {
+            while (running.size() < jobs_ && next < subsets.size()) {
+                std::fflush(stdout);
+                std::fflush(stderr);
+                pid_t pid = ::fork();
+                if (pid < 0) {
+                    throw std::system_error(errno, std::generic_category(), "fork");
+                }
+                if (pid == 0) {
+                    ProbeMain(subsets[next], reached[next]);
+                }
+                running.emplace_back(pid, next++);
+            }
+            auto finished = std::erase_if(running, [&](const auto& probe) {
+                int status = 0;
+                if (::waitpid(probe.first, &status, WNOHANG) != probe.first) {
+                    return false;
+                }
+                auto failed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+                polluted[probe.second] =
+                    failed && reached[probe.second].load(std::memory_order_acquire) != 0;
+                return true;
+            });
+            if (finished == 0 && !running.empty()) {
+                std::this_thread::sleep_for(200us);
+            }
+        }
+        return polluted;
+    }
+
+    [[noreturn]] void ProbeMain(const std::vector<std::size_t>& subset,
+                                std::atomic<std::uint32_t>& reached) {
+        int null = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+        if (null >= 0) {
+            ::dup2(null, STDOUT_FILENO);
+            ::dup2(null, STDERR_FILENO);
+            ::close(null);
+        }
+        rlimit no_core{.rlim_cur = 0, .rlim_max = 0};
+        ::setrlimit(RLIMIT_CORE, &no_core);
+
+        for (auto index : subset) {
+            try {
+                tests_[index].callable();
+            } catch (...) {  // NOLINT(bugprone-empty-catch): only the target's result matters
+            }
+        }
+        reached.store(1, std::memory_order_release);
+        try {
+            tests_[target_].callable();
+        } catch (...) {
+            ::_exit(1);
+        }
+        ::_exit(0);
+    }
+};
+
+// Runs a PolluterBisection for the test named "Suite::Test" and prints the result.
+// Returns 0 when a polluting set was found.
+inline auto BisectPolluter(std::span<const TestEntry> tests, std::string_view target,
+                           std::size_t jobs) -> int {
+    auto found = NameIndex(tests).Find(target);
+    if (!found) {
+        std::println(stderr, "error: no test named '{}'", target);
+        return 1;
+    }
+    if (jobs == 0) {
+        jobs = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    std::size_t index = *found;
+    PolluterBisection bisection(tests, index, jobs);
+    auto outcome = bisection.Run();
+    using Kind = PolluterBisection::Outcome::Kind;
+
+    switch (outcome.kind) {
+        case Kind::kFailsAlone:
+            std::println("bisect: {} fails on its own", target);
+            break;
+        case Kind::kNotReproduced:
+            std::println("bisect: {} passes after the {} tests before it", target, index);
+            break;
+        case Kind::kFound:
+            std::println("bisect: {} fails after:", target);
+            for (auto polluter : outcome.polluters) {
+                std::println("  {}::{}", tests[polluter].suite_name, tests[polluter].test_name);
+            }
+            break;
+    }
+    std::println("bisect: {} probes in {} rounds, up to {} at a time", outcome.probes,
+                 outcome.rounds, jobs);
+    return outcome.kind == Kind::kFound ? 0 : 1;
+}
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_BISECT_HPP_
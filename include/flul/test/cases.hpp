@@ -0,0 +1,137 @@
+#ifndef FLUL_TEST_CASES_HPP_
+#define FLUL_TEST_CASES_HPP_
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace flul::test {
+
+// A source of parameters for a parameterized test: a size and an indexed accessor that
+// produces case `i` on demand. Random-access views such as
+// `std::views::iota(0, n) | std::views::transform(f)` qualify as they are, so cases can
+// be computed rather than stored.
+template <typename C, typename P>
+concept CaseSource = std::copy_constructible<C> && requires(const C& cases, std::size_t i) {
+    { std::ranges::size(cases) } -> std::convertible_to<std::size_t>;
+    { cases[i] } -> std::convertible_to<P>;
+};
+
+// `count` cases produced by calling `make(i)`.
+template <typename F>
+struct GeneratedCases {
+    std::size_t count;
+    F make;
+
+    [[nodiscard]] auto size() const -> std::size_t {  // NOLINT(readability-identifier-naming)
+        return count;
+    }
+
+    auto operator[](std::size_t i) const {
+        return make(i);
+    }
+};
+
+template <typename F>
+    requires std::invocable<const F&, std::size_t>
+auto GenerateCases(std::size_t count, F make) -> GeneratedCases<F> {
+    return {.count = count, .make = std::move(make)};
+}
+
+// One case per line of a text file, read when the case runs. Blank lines and lines
+// starting with '#' are skipped and surrounding whitespace is trimmed, as for
+// --tests-from. Construction scans the file once and keeps only the line offsets.
+// Throws std::runtime_error if the file cannot be read.
+class LineCases {
+   public:
+    explicit LineCases(std::string path) : path_(std::move(path)) {
+        std::ifstream file(path_, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("cannot read case table '" + path_ + "'");
+        }
+        std::streamoff offset = 0;
+        for (std::string line; std::getline(file, line);) {
+            auto trimmed = Trim(line);
+            if (!trimmed.empty() && !trimmed.starts_with('#')) {
+                offsets_.push_back(offset);
+            }
+            offset += static_cast<std::streamoff>(line.size()) + 1;
+        }
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {  // NOLINT(readability-identifier-naming)
+        return offsets_.size();
+    }
+
+    // Opens the file per call, so cases may be read from several threads at once.
+    auto operator[](std::size_t i) const -> std::string {
+        std::ifstream file(path_, std::ios::binary);
+        std::string line;
+        if (!file.seekg(offsets_[i]) || !std::getline(file, line)) {
+            throw std::runtime_error("case table '" + path_ + "' changed while running");
+        }
+        return std::string(Trim(line));
+    }
+
+   private:
+    std::string path_;
+    std::vector<std::streamoff> offsets_;  // start of each case's line
+
+    static auto Trim(std::string_view line) -> std::string_view {
+        auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        return line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+    }
+};
+
+// One case per regular file in a fuzzing corpus directory, in file name order, each
+// read as bytes when its case runs. Only the paths are kept; a missing directory
+// yields no cases, since the fuzzer creates it on first use.
+class CorpusCases {
+   public:
+    explicit CorpusCases(const std::filesystem::path& directory) {
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            if (entry.is_regular_file()) {
+                paths_.push_back(entry.path());
+            }
+        }
+        std::ranges::sort(paths_);
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {  // NOLINT(readability-identifier-naming)
+        return paths_.size();
+    }
+
+    auto operator[](std::size_t i) const -> std::vector<std::byte> {
+        std::ifstream file(paths_[i], std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("cannot read corpus entry '" + paths_[i].string() + "'");
+        }
+        std::vector<std::byte> input;
+        for (std::istreambuf_iterator<char> it(file), end; it != end; ++it) {
+            input.push_back(static_cast<std::byte>(*it));
+        }
+        return input;
+    }
+
+   private:
+    std::vector<std::filesystem::path> paths_;
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_CASES_HPP_
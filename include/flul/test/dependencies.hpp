@@ -0,0 +1,129 @@
+#ifndef FLUL_TEST_DEPENDENCIES_HPP_
+#define FLUL_TEST_DEPENDENCIES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <span>
+#include <vector>
+
+#include "flul/test/test_entry.hpp"
+#include "flul/test/test_result.hpp"
+
+namespace flul::test {
+
+// Tracks which tests of a dependency DAG may run next.
+//
+// `prerequisites[t]` lists the indices of the tests that must pass before test `t`
+// starts; an empty span means no test has prerequisites. Schedulers start with
+// Initial(), report each finished test to Complete() and run what it releases. When a
+// test fails, every test that depends on it, directly or transitively, is skipped.
+class DependencyTracker {
+   public:
+    static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+    struct Update {
+        std::vector<std::uint32_t> ready;    // prerequisites all passed
+        std::vector<std::uint32_t> skipped;  // can no longer run
+    };
+
+    DependencyTracker(std::size_t count, std::span<const std::vector<std::uint32_t>> prerequisites)
+        : dependents_(count), waiting_(count, 0), cause_(count, kNone) {
+        for (std::uint32_t t = 0; t < prerequisites.size(); ++t) {
+            waiting_[t] = static_cast<std::uint32_t>(prerequisites[t].size());
+            for (auto p : prerequisites[t]) {
+                dependents_[p].push_back(t);
+            }
+        }
+    }
+
+    // Tests without prerequisites, in index order.
+    [[nodiscard]] auto Initial() const -> std::vector<std::uint32_t> {
+        std::vector<std::uint32_t> ready;
+        for (std::uint32_t t = 0; t < waiting_.size(); ++t) {
+            if (waiting_[t] == 0) {
+                ready.push_back(t);
+            }
+        }
+        return ready;
+    }
+
+    auto Complete(std::uint32_t test, bool passed) -> Update {
+        Update update;
+        if (passed) {
+            for (auto d : dependents_[test]) {
+                if (cause_[d] == kNone && --waiting_[d] == 0) {
+                    update.ready.push_back(d);
+                }
+            }
+            return update;
+        }
+
+        std::vector<std::uint32_t> pending = dependents_[test];
+        while (!pending.empty()) {
+            auto d = pending.back();
+            pending.pop_back();
+            if (cause_[d] != kNone) {
+                continue;
+            }
+            cause_[d] = test;
+            update.skipped.push_back(d);
+            pending.insert(pending.end(), dependents_[d].begin(), dependents_[d].end());
+        }
+        return update;
+    }
+
+    // The failed test that caused `test` to be skipped, or kNone.
+    [[nodiscard]] auto Cause(std::uint32_t test) const -> std::uint32_t {
+        return cause_[test];
+    }
+
+    // An order in which every test follows its prerequisites, otherwise keeping index
+    // order. Does not modify the tracker.
+    [[nodiscard]] auto Order() const -> std::vector<std::uint32_t> {
+        auto waiting = waiting_;
+        std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<>> ready;
+        for (auto t : Initial()) {
+            ready.push(t);
+        }
+        std::vector<std::uint32_t> order;
+        order.reserve(waiting.size());
+        while (!ready.empty()) {
+            auto t = ready.top();
+            ready.pop();
+            order.push_back(t);
+            for (auto d : dependents_[t]) {
+                if (--waiting[d] == 0) {
+                    ready.push(d);
+                }
+            }
+        }
+        return order;
+    }
+
+   private:
+    std::vector<std::vector<std::uint32_t>> dependents_;
+    std::vector<std::uint32_t> waiting_;  // prerequisites that have not passed yet
+    std::vector<std::uint32_t> cause_;
+};
+
+// Result reported for tests[test], skipped because its prerequisite tests[cause] did not
+// pass.
+inline auto SkippedResult(std::span<const TestEntry> tests, std::uint32_t test,
+                          std::uint32_t cause) -> TestResult {
+    return {.suite_name = tests[test].suite_name,
+            .test_name = tests[test].test_name,
+            .id = test,
+            .passed = false,
+            .duration = {},
+            .error = std::nullopt,
+            .skipped = std::format("prerequisite {}::{} did not pass", tests[cause].suite_name,
+                                   tests[cause].test_name)};
+}
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_DEPENDENCIES_HPP_
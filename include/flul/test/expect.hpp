@@ -4,8 +4,10 @@
 #include <concepts>
 #include <source_location>
 #include <string>
+#include <utility>
 
 #include "flul/test/assertion_error.hpp"
+#include "flul/test/soft_failures.hpp"
 #include "flul/test/stringify.hpp"
 
 namespace flul::test {
@@ -14,6 +16,21 @@ template <typename T>
 class Expect {
     T actual_;
     std::source_location loc_;
+    bool soft_ = false;
+
+    // Throws, or for a soft expectation records the failure if a test is collecting.
+    constexpr void Fail(std::string expected) const {
+        AssertionError failure{Stringify(actual_), std::move(expected), loc_};
+        if (auto* soft = soft_ ? SoftFailures::Current() : nullptr) {
+            soft->Record(std::move(failure));
+            return;
+        }
+        throw failure;
+    }
+
+   protected:
+    constexpr Expect(T actual, std::source_location loc, bool soft)
+        : actual_(std::move(actual)), loc_(loc), soft_(soft) {}
 
    public:
     constexpr explicit Expect(T actual, std::source_location loc = std::source_location::current())
@@ -23,7 +40,7 @@ class Expect {
         requires std::equality_comparable<T>
     {
         if (self.actual_ != expected) {
-            throw AssertionError{Stringify(self.actual_), Stringify(expected), self.loc_};
+            self.Fail(Stringify(expected));
         }
         return std::forward<decltype(self)>(self);
     }
@@ -32,8 +49,7 @@ class Expect {
         requires std::equality_comparable<T>
     {
         if (self.actual_ == unexpected) {
-            throw AssertionError{Stringify(self.actual_), "not " + Stringify(unexpected),
-                                 self.loc_};
+            self.Fail("not " + Stringify(unexpected));
         }
         return std::forward<decltype(self)>(self);
     }
@@ -42,7 +58,7 @@ class Expect {
         requires std::convertible_to<T, bool>
     {
         if (!self.actual_) {
-            throw AssertionError{Stringify(self.actual_), "true", self.loc_};
+            self.Fail("true");
         }
         return std::forward<decltype(self)>(self);
     }
@@ -51,7 +67,7 @@ class Expect {
         requires std::convertible_to<T, bool>
     {
         if (self.actual_) {
-            throw AssertionError{Stringify(self.actual_), "false", self.loc_};
+            self.Fail("false");
         }
         return std::forward<decltype(self)>(self);
     }
@@ -60,8 +76,7 @@ class Expect {
         requires std::totally_ordered<T>
     {
         if (self.actual_ <= bound) {
-            throw AssertionError{Stringify(self.actual_), "greater than " + Stringify(bound),
-                                 self.loc_};
+            self.Fail("greater than " + Stringify(bound));
         }
         return std::forward<decltype(self)>(self);
     }
@@ -70,13 +85,30 @@ class Expect {
         requires std::totally_ordered<T>
     {
         if (self.actual_ >= bound) {
-            throw AssertionError{Stringify(self.actual_), "less than " + Stringify(bound),
-                                 self.loc_};
+            self.Fail("less than " + Stringify(bound));
         }
         return std::forward<decltype(self)>(self);
     }
 };
 
+// An Expect that does not stop the test: a failed matcher records the failure in the
+// running test's SoftFailures and returns, and the Runner reports every recorded failure
+// when the test ends. Meant for validation loops where the first mismatch says little
+// and an exception per element would dominate the run time. Without a collector on the
+// calling thread — outside a test, on a thread the test started, or inside CheckProperty
+// and ExpectCallable, which suspend it — it throws like Expect.
+//
+//     for (std::size_t i = 0; i < rows.size(); ++i) {
+//         ExpectSoft(Checksum(rows[i])).ToEqual(expected[i]);
+//     }
+template <typename T>
+class ExpectSoft : public Expect<T> {
+   public:
+    constexpr explicit ExpectSoft(T actual,
+                                  std::source_location loc = std::source_location::current())
+        : Expect<T>(std::move(actual), loc, true) {}
+};
+
 }  // namespace flul::test
 
 #endif  // FLUL_TEST_EXPECT_HPP_
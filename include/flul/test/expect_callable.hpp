@@ -2,14 +2,23 @@
 #define FLUL_TEST_EXPECT_CALLABLE_HPP_
 
 #include <concepts>
+#include <csignal>
+#include <cstring>
+#include <format>
+#include <regex>
 #include <source_location>
+#include <string>
+#include <string_view>
 #include <typeinfo>
 
 #include "flul/test/assertion_error.hpp"
+#include "flul/test/soft_failures.hpp"
 #include "flul/test/stringify.hpp"
+#include "flul/test/subprocess.hpp"
 
 namespace flul::test {
 
+// Soft expectations inside the callable throw, so they count towards its outcome.
 template <std::invocable F>
 class ExpectCallable {
     F callable_;
@@ -22,6 +31,7 @@ class ExpectCallable {
 
     template <typename E>
     auto ToThrow() -> void {
+        SoftFailures::Suspend suspend;
         try {
             callable_();
         } catch (E&) {
@@ -41,6 +51,7 @@ class ExpectCallable {
     }
 
     auto ToNotThrow() -> void {
+        SoftFailures::Suspend suspend;
         try {
             callable_();
         } catch (std::exception& e) {
@@ -49,6 +60,63 @@ class ExpectCallable {
             throw AssertionError{"unknown exception", "no exception", loc_};
         }
     }
+
+    // Death assertions run the callable in a forked child (see RunInChild). The optional
+    // `pattern` is an ECMAScript regex that must match somewhere in the child's stderr.
+
+    auto ToAbort(std::string_view pattern = {}) -> void {
+        ToDieWithSignal(SIGABRT, pattern);
+    }
+
+    auto ToExitWith(int code, std::string_view pattern = {}) -> void {
+        SoftFailures::Suspend suspend;
+        auto outcome = RunInChild(callable_);
+        if (outcome.kind != ChildOutcome::Kind::kExited || outcome.code != code) {
+            throw AssertionError{Describe(outcome), std::format("exit with code {}", code), loc_};
+        }
+        CheckStderr(outcome, pattern);
+    }
+
+    auto ToDieWithSignal(int signal, std::string_view pattern = {}) -> void {
+        SoftFailures::Suspend suspend;
+        auto outcome = RunInChild(callable_);
+        if (outcome.kind != ChildOutcome::Kind::kSignaled || outcome.code != signal) {
+            throw AssertionError{Describe(outcome), "killed by " + SignalName(signal), loc_};
+        }
+        CheckStderr(outcome, pattern);
+    }
+
+   private:
+    auto CheckStderr(const ChildOutcome& outcome, std::string_view pattern) const -> void {
+        if (pattern.empty()) {
+            return;
+        }
+        if (!std::regex_search(outcome.stderr_text, std::regex(pattern.begin(), pattern.end()))) {
+            throw AssertionError{"stderr: " + outcome.stderr_text,
+                                 "stderr matching " + std::string(pattern), loc_};
+        }
+    }
+
+    static auto SignalName(int signal) -> std::string {
+        const char* name = ::strsignal(signal);  // NOLINT(concurrency-mt-unsafe)
+        return std::format("signal {} ({})", signal, name != nullptr ? name : "unknown");
+    }
+
+    static auto Describe(const ChildOutcome& outcome) -> std::string {
+        switch (outcome.kind) {
+            case ChildOutcome::Kind::kReturned:
+                return "returned normally";
+            case ChildOutcome::Kind::kThrew:
+                return "threw an exception";
+            case ChildOutcome::Kind::kExited:
+                return std::format("exited with code {}", outcome.code);
+            case ChildOutcome::Kind::kSignaled:
+                return "killed by " + SignalName(outcome.code);
+            case ChildOutcome::Kind::kTimedOut:
+                return std::format("still running after {}ms, killed", outcome.code);
+        }
+        return "unknown outcome";
+    }
 };
 
 }  // namespace flul::test
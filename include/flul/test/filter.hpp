@@ -0,0 +1,453 @@
+#ifndef FLUL_TEST_FILTER_HPP_
+#define FLUL_TEST_FILTER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "flul/test/test_entry.hpp"
+
+namespace flul::test {
+
+// A set of test-name patterns compiled into one automaton.
+//
+// Each pattern is matched against the full name "Suite::Test" in one of three forms:
+//
+//  - `re:<regex>` — found anywhere in the name unless anchored with a leading `^` or a
+//    trailing `$`. Supports literals, `.`, bracket classes, `*`, `+`, `?`, `|`, groups,
+//    and `\` to escape the next character.
+//  - a glob containing `*`, `?` or `[` — must match the whole name; `*` and `?` also
+//    match ':'. `[!...]` negates a class and `\` escapes.
+//  - anything else — a plain substring.
+//
+// All patterns are compiled to a single Thompson NFA, whose DFA states are built lazily
+// as names are matched and cached, so a filter pass costs one table lookup per byte of
+// each name. Suite and test name are fed separately with "::" between them; the joined
+// name is never built.
+class NamePatterns {
+   public:
+    // Bounds the DFA cache; when exceeded, the cache starts over.
+    static constexpr std::size_t kMaxDfaStates = 1024;
+
+    // Throws std::invalid_argument for malformed patterns.
+    explicit NamePatterns(std::span<const std::string_view> patterns) {
+        for (auto pattern : patterns) {
+            starts_.push_back(Compile(pattern));
+        }
+        Reset();
+    }
+
+    [[nodiscard]] auto Empty() const -> bool {
+        return starts_.empty();
+    }
+
+    // Whether any pattern matches "suite::test".
+    auto Matches(std::string_view suite, std::string_view test) -> bool {
+        return dfa_[Feed(Feed(Feed(kStart, suite), "::"), test)].accepting;
+    }
+
+    // Whether a pattern could match some test of `suite`, i.e. some "suite::...".
+    auto MayMatchSuite(std::string_view suite) -> bool {
+        return !dfa_[Feed(Feed(kStart, suite), "::")].dead;
+    }
+
+   private:
+    static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t kStart = 0;
+
+    using ByteSet = std::bitset<256>;
+
+    struct Node {
+        enum class Kind : std::uint8_t { kBytes, kSplit, kMatch };
+
+        Kind kind;
+        ByteSet bytes;  // kBytes: the bytes that advance to `out`
+        std::uint32_t out = kNone;
+        std::uint32_t out1 = kNone;  // kSplit: second epsilon edge, if any
+    };
+
+    // A partially built NFA: its entry node and the edges still to be connected.
+    struct Fragment {
+        struct Hole {
+            std::uint32_t node;
+            bool second;
+        };
+
+        std::uint32_t start;
+        std::vector<Hole> holes;
+    };
+
+    struct DfaState {
+        std::vector<std::uint32_t> nodes;  // sorted NFA nodes, after epsilon closure
+        std::array<std::uint32_t, 256> next;
+        bool accepting = false;
+        bool dead = false;
+    };
+
+    std::vector<Node> nfa_;
+    std::vector<std::uint32_t> starts_;  // one entry node per pattern
+    std::vector<DfaState> dfa_;
+    std::map<std::vector<std::uint32_t>, std::uint32_t> dfa_ids_;
+    std::vector<std::uint32_t> marks_;  // closure visit generation per NFA node
+    std::uint32_t generation_ = 0;
+
+    // NFA construction
+
+    auto AddNode(Node::Kind kind, const ByteSet& bytes = {}) -> std::uint32_t {
+        nfa_.push_back({.kind = kind, .bytes = bytes});
+        return static_cast<std::uint32_t>(nfa_.size() - 1);
+    }
+
+    void Patch(const std::vector<Fragment::Hole>& holes, std::uint32_t target) {
+        for (auto hole : holes) {
+            (hole.second ? nfa_[hole.node].out1 : nfa_[hole.node].out) = target;
+        }
+    }
+
+    auto Bytes(const ByteSet& bytes) -> Fragment {
+        auto node = AddNode(Node::Kind::kBytes, bytes);
+        return {.start = node, .holes = {{.node = node, .second = false}}};
+    }
+
+    auto Byte(char c) -> Fragment {
+        ByteSet bytes;
+        bytes.set(static_cast<unsigned char>(c));
+        return Bytes(bytes);
+    }
+
+    auto Epsilon() -> Fragment {
+        auto node = AddNode(Node::Kind::kSplit);
+        return {.start = node, .holes = {{.node = node, .second = false}}};
+    }
+
+    auto Concat(Fragment a, Fragment b) -> Fragment {
+        Patch(a.holes, b.start);
+        return {.start = a.start, .holes = std::move(b.holes)};
+    }
+
+    auto Alternate(Fragment a, Fragment b) -> Fragment {
+        auto node = AddNode(Node::Kind::kSplit);
+        nfa_[node].out = a.start;
+        nfa_[node].out1 = b.start;
+        a.holes.insert(a.holes.end(), b.holes.begin(), b.holes.end());
+        return {.start = node, .holes = std::move(a.holes)};
+    }
+
+    auto Repeat(Fragment a, char op) -> Fragment {
+        auto node = AddNode(Node::Kind::kSplit);
+        nfa_[node].out = a.start;
+        Fragment::Hole exit{.node = node, .second = true};
+        switch (op) {
+            case '*':
+                Patch(a.holes, node);
+                return {.start = node, .holes = {exit}};
+            case '+':
+                Patch(a.holes, node);
+                return {.start = a.start, .holes = {exit}};
+            default:  // '?'
+                a.holes.push_back(exit);
+                return {.start = node, .holes = std::move(a.holes)};
+        }
+    }
+
+    auto AnyString() -> Fragment {
+        return Repeat(Bytes(ByteSet().set()), '*');
+    }
+
+    // Pattern parsing
+
+    class Parser {
+       public:
+        Parser(NamePatterns& owner, std::string_view pattern, std::string_view text)
+            : owner_(owner), pattern_(pattern), text_(text) {}
+
+        auto Done() const -> bool {
+            return pos_ == text_.size();
+        }
+
+        auto Peek() const -> char {
+            return text_[pos_];
+        }
+
+        auto Take() -> char {
+            return text_[pos_++];
+        }
+
+        [[noreturn]] void Fail(std::string_view what) const {
+            throw std::invalid_argument(std::format("invalid pattern '{}': {}", pattern_, what));
+        }
+
+        auto Escaped() -> char {
+            if (Done()) {
+                Fail("trailing '\\'");
+            }
+            return Take();
+        }
+
+        auto ClassByte() -> unsigned char {
+            auto c = Take();
+            return static_cast<unsigned char>(c == '\\' ? Escaped() : c);
+        }
+
+        // Parses a bracket class after its '['.
+        auto Class(bool glob) -> Fragment {
+            ByteSet bytes;
+            bool negate = !Done() && (Peek() == '^' || (glob && Peek() == '!'));
+            if (negate) {
+                Take();
+            }
+            bool first = true;
+            while (!Done() && (Peek() != ']' || first)) {
+                first = false;
+                auto lo = ClassByte();
+                auto hi = lo;
+                if (pos_ + 1 < text_.size() && Peek() == '-' && text_[pos_ + 1] != ']') {
+                    Take();
+                    hi = ClassByte();
+                    if (hi < lo) {
+                        Fail("reversed range in class");
+                    }
+                }
+                for (unsigned c = lo; c <= hi; ++c) {
+                    bytes.set(c);
+                }
+            }
+            if (Done()) {
+                Fail("unterminated '['");
+            }
+            Take();
+            return owner_.Bytes(negate ? ~bytes : bytes);
+        }
+
+        // alternation := sequence ('|' sequence)*
+        auto Alternation() -> Fragment {
+            auto fragment = Sequence();
+            while (!Done() && Peek() == '|') {
+                Take();
+                fragment = owner_.Alternate(std::move(fragment), Sequence());
+            }
+            return fragment;
+        }
+
+        // sequence := (atom ('*' | '+' | '?')*)*
+        auto Sequence() -> Fragment {
+            auto fragment = owner_.Epsilon();
+            while (!Done() && Peek() != '|' && Peek() != ')') {
+                auto atom = Atom();
+                while (!Done() && (Peek() == '*' || Peek() == '+' || Peek() == '?')) {
+                    atom = owner_.Repeat(std::move(atom), Take());
+                }
+                fragment = owner_.Concat(std::move(fragment), std::move(atom));
+            }
+            return fragment;
+        }
+
+        auto Atom() -> Fragment {
+            auto c = Take();
+            switch (c) {
+                case '(': {
+                    auto group = Alternation();
+                    if (Done() || Take() != ')') {
+                        Fail("unbalanced '('");
+                    }
+                    return group;
+                }
+                case '[':
+                    return Class(false);
+                case '.':
+                    return owner_.Bytes(ByteSet().set());
+                case '\\':
+                    return owner_.Byte(Escaped());
+                case '*':
+                case '+':
+                case '?':
+                    Fail(std::format("nothing to repeat before '{}'", c));
+                default:
+                    return owner_.Byte(c);
+            }
+        }
+
+        auto Glob() -> Fragment {
+            auto fragment = owner_.Epsilon();
+            while (!Done()) {
+                auto c = Take();
+                Fragment next = c == '*'    ? owner_.AnyString()
+                                : c == '?'  ? owner_.Bytes(ByteSet().set())
+                                : c == '['  ? Class(true)
+                                : c == '\\' ? owner_.Byte(Escaped())
+                                            : owner_.Byte(c);
+                fragment = owner_.Concat(std::move(fragment), std::move(next));
+            }
+            return fragment;
+        }
+
+       private:
+        NamePatterns& owner_;
+        std::string_view pattern_;
+        std::string_view text_;
+        std::size_t pos_ = 0;
+    };
+
+    auto Compile(std::string_view pattern) -> std::uint32_t {
+        Fragment fragment{};
+        if (pattern.starts_with("re:")) {
+            auto text = pattern.substr(3);
+            bool anchored_start = text.starts_with('^');
+            if (anchored_start) {
+                text.remove_prefix(1);
+            }
+            bool anchored_end = false;
+            if (text.ends_with('$')) {
+                // A '$' preceded by an odd number of backslashes is a literal.
+                auto body = text.substr(0, text.size() - 1);
+                auto last = body.find_last_not_of('\\');
+                auto slashes = body.size() - (last == std::string_view::npos ? 0 : last + 1);
+                anchored_end = slashes % 2 == 0;
+            }
+            if (anchored_end) {
+                text.remove_suffix(1);
+            }
+            Parser parser(*this, pattern, text);
+            fragment = parser.Alternation();
+            if (!parser.Done()) {
+                parser.Fail("unbalanced ')'");
+            }
+            if (!anchored_start) {
+                fragment = Concat(AnyString(), std::move(fragment));
+            }
+            if (!anchored_end) {
+                fragment = Concat(std::move(fragment), AnyString());
+            }
+        } else if (pattern.find_first_of("*?[") != std::string_view::npos) {
+            fragment = Parser(*this, pattern, pattern).Glob();
+        } else {
+            fragment = AnyString();
+            for (auto c : pattern) {
+                fragment = Concat(std::move(fragment), Byte(c));
+            }
+            fragment = Concat(std::move(fragment), AnyString());
+        }
+        Patch(fragment.holes, AddNode(Node::Kind::kMatch));
+        return fragment.start;
+    }
+
+    // Lazy DFA
+
+    // Adds the NFA nodes reachable from `node` over epsilon edges; only byte and match
+    // nodes are kept, since they alone determine future behaviour.
+    void Close(std::uint32_t node, std::vector<std::uint32_t>& set) {
+        std::vector<std::uint32_t> pending{node};
+        while (!pending.empty()) {
+            auto n = pending.back();
+            pending.pop_back();
+            if (n == kNone || marks_[n] == generation_) {
+                continue;
+            }
+            marks_[n] = generation_;
+            if (nfa_[n].kind == Node::Kind::kSplit) {
+                pending.push_back(nfa_[n].out1);
+                pending.push_back(nfa_[n].out);
+            } else {
+                set.push_back(n);
+            }
+        }
+    }
+
+    auto Intern(std::vector<std::uint32_t> nodes) -> std::uint32_t {
+        std::ranges::sort(nodes);
+        if (auto it = dfa_ids_.find(nodes); it != dfa_ids_.end()) {
+            return it->second;
+        }
+        DfaState state{.nodes = nodes, .next = {}};
+        state.next.fill(kNone);
+        state.dead = nodes.empty();
+        state.accepting = std::ranges::any_of(
+            nodes, [this](std::uint32_t n) { return nfa_[n].kind == Node::Kind::kMatch; });
+        auto id = static_cast<std::uint32_t>(dfa_.size());
+        dfa_.push_back(std::move(state));
+        dfa_ids_.emplace(std::move(nodes), id);
+        return id;
+    }
+
+    void Reset() {
+        dfa_.clear();
+        dfa_ids_.clear();
+        marks_.assign(nfa_.size(), 0);
+        generation_ = 1;
+        std::vector<std::uint32_t> start;
+        for (auto node : starts_) {
+            Close(node, start);
+        }
+        Intern(std::move(start));
+    }
+
+    // Runs `text` through the DFA from `state`, stopping early in the dead state.
+    auto Feed(std::uint32_t state, std::string_view text) -> std::uint32_t {
+        for (auto c : text) {
+            if (dfa_[state].dead) {
+                break;
+            }
+            state = Step(state, static_cast<unsigned char>(c));
+        }
+        return state;
+    }
+
+    auto Step(std::uint32_t state, unsigned char byte) -> std::uint32_t {
+        if (auto next = dfa_[state].next[byte]; next != kNone) {
+            return next;
+        }
+        ++generation_;
+        std::vector<std::uint32_t> target;
+        for (auto n : dfa_[state].nodes) {
+            if (nfa_[n].kind == Node::Kind::kBytes && nfa_[n].bytes.test(byte)) {
+                Close(nfa_[n].out, target);
+            }
+        }
+        // A full cache starts over; `state` is gone then, so the transition is not cached.
+        bool flush = dfa_.size() >= kMaxDfaStates;
+        if (flush) {
+            Reset();
+        }
+        auto next = Intern(std::move(target));
+        if (!flush) {
+            dfa_[state].next[byte] = next;
+        }
+        return next;
+    }
+};
+
+// Test selection from --filter and --exclude patterns: a test is kept when it matches
+// an include pattern (or none were given) and no exclude pattern.
+class TestFilter {
+   public:
+    TestFilter(std::span<const std::string_view> includes,
+               std::span<const std::string_view> excludes)
+        : includes_(includes), excludes_(excludes) {}
+
+    auto Selects(const TestEntry& test) -> bool {
+        return (includes_.Empty() || includes_.Matches(test.suite_name, test.test_name)) &&
+               (excludes_.Empty() || !excludes_.Matches(test.suite_name, test.test_name));
+    }
+
+    // False when no test of `suite` can be selected, so it need not be registered.
+    auto MayMatchSuite(std::string_view suite) -> bool {
+        return includes_.Empty() || includes_.MayMatchSuite(suite);
+    }
+
+   private:
+    NamePatterns includes_;
+    NamePatterns excludes_;
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_FILTER_HPP_
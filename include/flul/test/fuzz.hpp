@@ -0,0 +1,211 @@
+#ifndef FLUL_TEST_FUZZ_HPP_
+#define FLUL_TEST_FUZZ_HPP_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "flul/test/property.hpp"
+#include "flul/test/registry.hpp"
+#include "flul/test/test_entry.hpp"
+
+namespace flul::test {
+
+struct FuzzOptions {
+    // Stop after this many inputs; 0 means no limit.
+    std::size_t runs = 0;
+    // Stop after this long.
+    std::chrono::nanoseconds time = std::chrono::seconds(60);
+    // Mutations never grow an input beyond this many bytes.
+    std::size_t max_length = 4096;
+    std::uint64_t seed = 0;
+    // Directory receiving the input of a failing run as crash-<hash>.
+    std::filesystem::path crash_directory = ".";
+};
+
+// Applies one to four random edits to `input`: bit flips, random or boundary bytes,
+// insertions, erasures, copies within the input and splices from `corpus`.
+inline void Mutate(std::vector<std::byte>& input, SplitMix64& rng,
+                   std::span<const std::vector<std::byte>> corpus, std::size_t max_length) {
+    static constexpr std::array kBoundaryBytes = {std::byte{0x00}, std::byte{0x01},
+                                                  std::byte{0x7f}, std::byte{0x80},
+                                                  std::byte{0xff}};
+    auto below = [&](std::size_t n) -> std::size_t { return rng.Next() % n; };
+    auto random_byte = [&] { return static_cast<std::byte>(rng.Next()); };
+
+    for (auto edits = 1 + below(4); edits > 0; --edits) {
+        auto size = input.size();
+        switch (below(7)) {
+            case 0:  // flip one bit
+                if (size > 0) {
+                    input[below(size)] ^= std::byte{1} << below(8);
+                }
+                break;
+            case 1:  // overwrite one byte
+                if (size > 0) {
+                    input[below(size)] = random_byte();
+                }
+                break;
+            case 2:  // overwrite one byte with a boundary value
+                if (size > 0) {
+                    input[below(size)] = kBoundaryBytes[below(kBoundaryBytes.size())];
+                }
+                break;
+            case 3:  // insert one byte
+                if (size < max_length) {
+                    input.insert(input.begin() + static_cast<std::ptrdiff_t>(below(size + 1)),
+                                 random_byte());
+                }
+                break;
+            case 4:  // erase a run of bytes
+                if (size > 0) {
+                    auto first = below(size);
+                    auto count = 1 + below(std::min<std::size_t>(size - first, 8));
+                    auto begin = input.begin() + static_cast<std::ptrdiff_t>(first);
+                    input.erase(begin, begin + static_cast<std::ptrdiff_t>(count));
+                }
+                break;
+            case 5:  // copy a run of bytes over another position
+                if (size > 1) {
+                    auto from = below(size);
+                    auto to = below(size);
+                    auto count = 1 + below(size - std::max(from, to));
+                    auto source = input.begin() + static_cast<std::ptrdiff_t>(from);
+                    const std::vector<std::byte> chunk(source,
+                                                       source + static_cast<std::ptrdiff_t>(count));
+                    std::ranges::copy(chunk, input.begin() + static_cast<std::ptrdiff_t>(to));
+                }
+                break;
+            default:  // splice: keep a prefix, append the tail of another corpus entry
+                if (!corpus.empty()) {
+                    const auto& other = corpus[below(corpus.size())];
+                    input.resize(below(size + 1));
+                    auto tail = other.begin() +
+                                static_cast<std::ptrdiff_t>(below(other.size() + 1));
+                    auto room = max_length - std::min(max_length, input.size());
+                    auto count = std::min<std::size_t>(
+                        room, static_cast<std::size_t>(other.end() - tail));
+                    input.insert(input.end(), tail, tail + static_cast<std::ptrdiff_t>(count));
+                }
+                break;
+        }
+    }
+}
+
+// Runs `target` once on `input`, returning the failure message if it throws.
+inline auto TryFuzzInput(const FuzzTarget& target, std::span<const std::byte> input)
+    -> std::optional<std::string> {
+    try {
+        target(input);
+    } catch (const std::exception& e) {
+        return e.what();
+    } catch (...) {
+        return "non-standard exception";
+    }
+    return std::nullopt;
+}
+
+// Saves a failing input as `directory`/crash-<FNV-1a hash>, returning the path.
+inline auto SaveCrash(const std::filesystem::path& directory, std::span<const std::byte> input)
+    -> std::filesystem::path {
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (auto b : input) {
+        hash = (hash ^ static_cast<std::uint64_t>(b)) * 0x100000001b3;
+    }
+    auto path = directory / std::format("crash-{:016x}", hash);
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(input.data()),  // NOLINT(*-reinterpret-cast)
+               static_cast<std::streamsize>(input.size()));
+    return path;
+}
+
+// In-process mutational fuzzing of `target`, starting from `corpus` (or one empty input).
+//
+// Without compiler coverage instrumentation this is blind: inputs are random mutations
+// of the corpus, and nothing is added to it. For coverage-guided fuzzing, build the
+// target into a libFuzzer binary with FLUL_FUZZ_ENTRY_POINT. Stops at the first input
+// that makes the target throw, saves it with SaveCrash and returns 1; returns 0 when
+// the run or time budget is spent. A crashing signal ends the process, as it would a
+// test.
+inline auto Fuzz(const FuzzTarget& target, std::vector<std::vector<std::byte>> corpus,
+                 const FuzzOptions& options) -> int {
+    if (corpus.empty()) {
+        corpus.emplace_back();
+    }
+    for (const auto& input : corpus) {
+        if (auto failure = TryFuzzInput(target, input)) {
+            std::println(stderr, "fuzz: corpus entry fails: {}", *failure);
+            return 1;
+        }
+    }
+
+    SplitMix64 rng(options.seed);
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + options.time;
+    std::size_t runs = 0;
+    std::vector<std::byte> input;
+    for (; options.runs == 0 || runs < options.runs; ++runs) {
+        // Read the clock every 256 runs only: small targets run millions of times a second.
+        if (runs % 256 == 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        input = corpus[rng.Next() % corpus.size()];
+        Mutate(input, rng, corpus, options.max_length);
+        if (auto failure = TryFuzzInput(target, input)) {
+            auto path = SaveCrash(options.crash_directory, input);
+            std::println(stderr,
+                         "fuzz: {}::{} failed after {} runs (seed {:#x}): {}\n"
+                         "fuzz: input saved to {}",
+                         target.suite_name, target.test_name, runs + 1, options.seed, *failure,
+                         path.string());
+            return 1;
+        }
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    std::println("fuzz: {}::{}: {} runs in {:.1f}s (seed {:#x}), no failure",
+                 target.suite_name, target.test_name, runs, elapsed.count(), options.seed);
+    return 0;
+}
+
+}  // namespace flul::test
+
+// Defines LLVMFuzzerTestOneInput, the entry point of a binary linked with
+// -fsanitize=fuzzer, calling the fuzz target `name` ("Suite::Test") that
+// `register_tests` adds to a registry. Use in exactly one translation unit. A target that
+// throws is reported to libFuzzer as a crash, after its message is printed.
+#define FLUL_FUZZ_ENTRY_POINT(register_tests, name)                                        \
+    extern "C" auto LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)     \
+        -> int {                                                                           \
+        static const ::flul::test::FuzzTarget* const target = [] {                        \
+            static ::flul::test::Registry registry;                                        \
+            (register_tests)(registry);                                                    \
+            registry.ExpandAll();                                                          \
+            const auto* found = registry.FindFuzzTarget(name);                             \
+            if (found == nullptr) {                                                        \
+                std::println(stderr, "error: no fuzz target named '{}'", name);            \
+                std::exit(1); /* NOLINT(concurrency-mt-unsafe) */                          \
+            }                                                                              \
+            return found;                                                                  \
+        }();                                                                               \
+        if (auto failure = ::flul::test::TryFuzzInput(                                     \
+                *target, std::as_bytes(std::span(data, size)))) {                          \
+            std::println(stderr, "{}", *failure);                                          \
+            std::abort();                                                                  \
+        }                                                                                  \
+        return 0;                                                                          \
+    }
+
+#endif  // FLUL_TEST_FUZZ_HPP_
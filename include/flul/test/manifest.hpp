@@ -0,0 +1,135 @@
+#ifndef FLUL_TEST_MANIFEST_HPP_
+#define FLUL_TEST_MANIFEST_HPP_
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include "flul/test/test_entry.hpp"
+
+namespace flul::test {
+
+// A compile-time test entry with the attributes the build-time manifest records for it.
+// `tags` are comma-separated; a timeout or cost of 0 is left unset.
+struct ManifestEntry {
+    TestEntry test;
+    std::string_view tags{};
+    unsigned timeout_seconds = 0;
+    // Relative cost hint, used by CTest to start expensive tests first.
+    unsigned cost = 0;
+};
+
+// The TestEntry table of a manifest table, for Registry(span) and JoinTables. The
+// entries carry no tags: tag bits belong to a registry, so use Registry::AddManifest
+// where --tags should see them.
+template <std::size_t N>
+consteval auto ManifestTests(const std::array<ManifestEntry, N>& manifest)
+    -> std::array<TestEntry, N> {
+    std::array<TestEntry, N> tests{};
+    for (std::size_t i = 0; i < N; ++i) {
+        tests[i] = manifest[i].test;
+    }
+    return tests;
+}
+
+namespace detail {
+
+// Writes the manifest lines of `manifest` through `put`, one character at a time.
+template <typename Put>
+constexpr void WriteManifest(std::span<const ManifestEntry> manifest, Put put) {
+    auto text = [&](std::string_view s) {
+        for (char c : s) {
+            put(c);
+        }
+    };
+    auto decimal = [&](unsigned value) {
+        std::array<char, 10> digits{};
+        std::size_t n = 0;
+        do {
+            digits[n++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (n > 0) {
+            put(digits[--n]);
+        }
+    };
+    for (const auto& entry : manifest) {
+        text(entry.test.suite_name);
+        text("::");
+        text(entry.test.test_name);
+        put('\t');
+        text(entry.tags);
+        put('\t');
+        decimal(entry.timeout_seconds);
+        put('\t');
+        decimal(entry.cost);
+        put('\n');
+    }
+}
+
+consteval auto ManifestSize(std::span<const ManifestEntry> manifest) -> std::size_t {
+    std::size_t size = 0;
+    WriteManifest(manifest, [&](char /*c*/) { ++size; });
+    return size;
+}
+
+// The manifest text, without a terminating NUL so that the text of several tables
+// concatenates cleanly in the section.
+template <std::size_t Size, std::size_t N>
+consteval auto ManifestText(const std::array<ManifestEntry, N>& manifest)
+    -> std::array<char, Size> {
+    std::array<char, Size> text{};
+    std::size_t next = 0;
+    WriteManifest(manifest, [&](char c) { text[next++] = c; });
+    return text;
+}
+
+// Section bounds provided by the linker; null when no table is in the manifest.
+// NOLINTBEGIN(*-avoid-c-arrays,readability-identifier-naming,bugprone-reserved-identifier)
+extern "C" [[gnu::weak]] const char __start_flul_manifest[];
+extern "C" [[gnu::weak]] const char __stop_flul_manifest[];
+// NOLINTEND(*-avoid-c-arrays,readability-identifier-naming,bugprone-reserved-identifier)
+
+}  // namespace detail
+
+// The manifest lines linked into this binary, in link order.
+inline auto Manifest() -> std::string_view {
+    if (detail::__start_flul_manifest == nullptr) {
+        return {};
+    }
+    return {detail::__start_flul_manifest,
+            static_cast<std::size_t>(detail::__stop_flul_manifest -
+                                     detail::__start_flul_manifest)};
+}
+
+}  // namespace flul::test
+
+// Records the constexpr ManifestEntry array `table` in the flul_manifest section of the
+// linked binary, one line per test:
+//
+//     Suite::Test<TAB>tag,tag<TAB>timeout seconds<TAB>cost
+//
+// For example:
+//
+//     inline constexpr std::array kIoManifest = {
+//         ManifestEntry{StaticTest<&IoSuite::Read>("IoSuite", "Read"), "io,slow", 30, 5},
+//         ManifestEntry{StaticTest<&IoSuite::Write>("IoSuite", "Write")},
+//     };
+//     FLUL_TEST_MANIFEST(kIoManifest);
+//     ...
+//     registry.AddManifest(kIoManifest);
+//
+// The section is read-only data, so `objcopy --dump-section` extracts it from the binary
+// without running it: flul_test_discover(<target> MANIFEST) registers CTest tests from
+// it, which also works when cross-building. Use at namespace scope. The text has internal
+// linkage, so a table recorded in a header appears once per translation unit; discovery
+// drops the duplicate lines. GCC ignores section attributes on template instantiations,
+// which is why this is a macro rather than part of StaticTest.
+#define FLUL_TEST_MANIFEST(table)                                                          \
+    [[gnu::used, gnu::retain, gnu::section("flul_manifest")]] alignas(1) static constexpr \
+        auto table##_manifest_text =                                                       \
+            ::flul::test::detail::ManifestText<::flul::test::detail::ManifestSize(table)>( \
+                table)
+
+#endif  // FLUL_TEST_MANIFEST_HPP_
@@ -0,0 +1,391 @@
+#ifndef FLUL_TEST_MATRIX_HPP_
+#define FLUL_TEST_MATRIX_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace flul::test {
+
+// How many of the t-way value combinations of a matrix a set of its rows covers.
+struct InteractionCoverage {
+    std::size_t strength;
+    std::size_t covered;
+    std::size_t total;
+};
+
+// The rows of a parameter matrix as value indices, one per dimension: either every
+// combination, or a covering array of strength t, in which every combination of values
+// of any t dimensions appears in at least one row.
+class CombinationTable {
+   public:
+    // Every combination, last dimension varying fastest. Rows are decoded on demand, so
+    // the product is never stored.
+    static auto Product(std::vector<std::size_t> sizes) -> CombinationTable {
+        CombinationTable table(std::move(sizes), 0);
+        table.strength_ = table.sizes_.size();
+        table.count_ = table.ProductSize();
+        return table;
+    }
+
+    // A covering array built greedily, one row at a time: candidate rows start from an
+    // uncovered t-way combination and fill the other dimensions with the values covering
+    // the most new combinations, and the candidate covering the most is kept. The result
+    // depends only on `sizes` and `strength`. A strength of at least the number of
+    // dimensions is the full product.
+    static auto Covering(std::vector<std::size_t> sizes, std::size_t strength)
+        -> CombinationTable {
+        if (strength == 0) {
+            throw std::invalid_argument("covering array strength must be at least 1");
+        }
+        if (strength >= sizes.size()) {
+            return Product(std::move(sizes));
+        }
+        CombinationTable table(std::move(sizes), strength);
+        table.Cover();
+        return table;
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {  // NOLINT(readability-identifier-naming)
+        return count_;
+    }
+
+    [[nodiscard]] auto Dimensions() const -> std::size_t {
+        return sizes_.size();
+    }
+
+    [[nodiscard]] auto Strength() const -> std::size_t {
+        return strength_;
+    }
+
+    // The number of rows of the full product, or nullopt if it does not fit in a size_t.
+    [[nodiscard]] auto CountProduct() const -> std::optional<std::size_t> {
+        std::size_t product = 1;
+        for (auto size : sizes_) {
+            if (product > std::numeric_limits<std::size_t>::max() / size) {
+                return std::nullopt;
+            }
+            product *= size;
+        }
+        return product;
+    }
+
+    // The number of rows of the full product. Throws std::invalid_argument if it does not
+    // fit in a size_t.
+    [[nodiscard]] auto ProductSize() const -> std::size_t {
+        if (auto product = CountProduct()) {
+            return *product;
+        }
+        throw std::invalid_argument("a parameter matrix has too many combinations to count");
+    }
+
+    // The value index of dimension `dimension` in row `row`.
+    [[nodiscard]] auto Value(std::size_t row, std::size_t dimension) const -> std::size_t {
+        if (!rows_.empty()) {
+            return rows_[(row * sizes_.size()) + dimension];
+        }
+        for (auto d = sizes_.size() - 1; d > dimension; --d) {
+            row /= sizes_[d];
+        }
+        return row % sizes_[dimension];
+    }
+
+    // The t-way combinations, at this table's strength, that `rows` cover.
+    [[nodiscard]] auto Coverage(std::span<const std::uint32_t> rows) const
+        -> InteractionCoverage {
+        auto interactions = Interactions();
+        std::vector<bool> covered(interactions.total, false);
+        std::size_t count = 0;
+        std::vector<std::size_t> values(sizes_.size());
+        for (auto row : rows) {
+            for (std::size_t d = 0; d < sizes_.size(); ++d) {
+                values[d] = Value(row, d);
+            }
+            for (std::size_t s = 0; s < interactions.subsets.size(); ++s) {
+                auto index = interactions.Index(s, values);
+                count += covered[index] ? 0U : 1U;
+                covered[index] = true;
+            }
+        }
+        return {.strength = strength_, .covered = count, .total = interactions.total};
+    }
+
+   private:
+    // Every set of `strength_` dimensions, and for each a block of bits, one per
+    // combination of their values.
+    struct InteractionSet {
+        std::vector<std::vector<std::size_t>> subsets;  // dimension indices, ascending
+        std::vector<std::size_t> offsets;               // first bit of each subset's block
+        std::size_t total = 0;
+        const std::vector<std::size_t>* sizes = nullptr;
+
+        [[nodiscard]] auto Index(std::size_t s, std::span<const std::size_t> values) const
+            -> std::size_t {
+            std::size_t index = 0;
+            for (auto d : subsets[s]) {
+                index = (index * (*sizes)[d]) + values[d];
+            }
+            return offsets[s] + index;
+        }
+
+        // One past the last bit of subset `s`'s block.
+        [[nodiscard]] auto End(std::size_t s) const -> std::size_t {
+            return s + 1 < offsets.size() ? offsets[s + 1] : total;
+        }
+
+        // Whether every combination of subset `s` is clear in `uncovered`.
+        [[nodiscard]] auto Covered(const std::vector<bool>& uncovered, std::size_t s) const
+            -> bool {
+            auto begin = uncovered.begin() + static_cast<std::ptrdiff_t>(offsets[s]);
+            auto end = uncovered.begin() + static_cast<std::ptrdiff_t>(End(s));
+            return std::find(begin, end, true) == end;
+        }
+    };
+
+    static constexpr std::size_t kUnset = static_cast<std::size_t>(-1);
+    // Candidate rows compared per row of a covering array.
+    static constexpr std::size_t kCandidates = 16;
+
+    std::vector<std::size_t> sizes_;
+    std::size_t strength_;
+    std::vector<std::uint32_t> rows_;  // row-major value indices; empty for a product
+    std::size_t count_ = 0;
+
+    CombinationTable(std::vector<std::size_t> sizes, std::size_t strength)
+        : sizes_(std::move(sizes)), strength_(strength) {
+        if (sizes_.empty()) {
+            throw std::invalid_argument("a parameter matrix needs at least one dimension");
+        }
+        for (auto size : sizes_) {
+            if (size == 0) {
+                throw std::invalid_argument("a parameter matrix dimension has no values");
+            }
+        }
+    }
+
+    [[nodiscard]] auto Interactions() const -> InteractionSet {
+        InteractionSet set{.subsets = {}, .offsets = {}, .sizes = &sizes_};
+        std::vector<std::size_t> subset(strength_);
+        for (std::size_t i = 0; i < strength_; ++i) {
+            subset[i] = i;
+        }
+        while (true) {
+            std::size_t block = 1;
+            for (auto d : subset) {
+                block *= sizes_[d];
+            }
+            set.subsets.push_back(subset);
+            set.offsets.push_back(set.total);
+            set.total += block;
+            // Next subset in lexicographic order.
+            auto i = strength_;
+            while (i > 0 && subset[i - 1] == sizes_.size() - strength_ + i - 1) {
+                --i;
+            }
+            if (i == 0) {
+                return set;
+            }
+            ++subset[i - 1];
+            for (auto j = i; j < strength_; ++j) {
+                subset[j] = subset[j - 1] + 1;
+            }
+        }
+    }
+
+    void Cover() {
+        auto interactions = Interactions();
+        std::vector<bool> uncovered(interactions.total, true);
+        auto remaining = interactions.total;
+        std::size_t next = 0;  // every combination before this subset is covered
+
+        // open[first_value[d] + v]: uncovered combinations with value v in dimension d.
+        std::vector<std::size_t> first_value(sizes_.size());
+        for (std::size_t d = 1; d < sizes_.size(); ++d) {
+            first_value[d] = first_value[d - 1] + sizes_[d - 1];
+        }
+        std::vector<std::size_t> open(first_value.back() + sizes_.back(), 0);
+        for (std::size_t s = 0; s < interactions.subsets.size(); ++s) {
+            auto block = interactions.End(s) - interactions.offsets[s];
+            for (auto d : interactions.subsets[s]) {
+                for (std::size_t v = 0; v < sizes_[d]; ++v) {
+                    open[first_value[d] + v] += block / sizes_[d];
+                }
+            }
+        }
+
+        std::vector<std::size_t> row(sizes_.size());
+        std::vector<std::size_t> best_row;
+        while (remaining > 0) {
+            while (interactions.Covered(uncovered, next)) {
+                ++next;
+            }
+            // Complete one candidate row per subset with uncovered combinations, from
+            // `next` on, and keep the one covering the most.
+            std::size_t best_covers = 0;
+            std::size_t candidates = 0;
+            for (auto s = next; s < interactions.subsets.size() && candidates < kCandidates;
+                 ++s) {
+                if (interactions.Covered(uncovered, s)) {
+                    continue;
+                }
+                ++candidates;
+                std::ranges::fill(row, kUnset);
+                Seed(interactions, uncovered, s, row);
+                Complete(interactions, uncovered, open, first_value, row);
+                std::size_t covers = 0;
+                for (std::size_t u = 0; u < interactions.subsets.size(); ++u) {
+                    covers += uncovered[interactions.Index(u, row)] ? 1U : 0U;
+                }
+                if (covers > best_covers) {
+                    best_covers = covers;
+                    best_row = row;
+                }
+            }
+            row = best_row;
+
+            for (std::size_t s = 0; s < interactions.subsets.size(); ++s) {
+                auto index = interactions.Index(s, row);
+                if (uncovered[index]) {
+                    uncovered[index] = false;
+                    --remaining;
+                    for (auto d : interactions.subsets[s]) {
+                        --open[first_value[d] + row[d]];
+                    }
+                }
+            }
+            for (auto value : row) {
+                rows_.push_back(static_cast<std::uint32_t>(value));
+            }
+            ++count_;
+        }
+    }
+
+    // Sets the unset dimensions of `row`, in order, to the value covering the most new
+    // combinations with the dimensions set so far; ties go to the value with the most
+    // uncovered combinations left, then to the lowest.
+    void Complete(const InteractionSet& interactions, const std::vector<bool>& uncovered,
+                  const std::vector<std::size_t>& open,
+                  const std::vector<std::size_t>& first_value,
+                  std::vector<std::size_t>& row) const {
+        for (std::size_t d = 0; d < sizes_.size(); ++d) {
+            if (row[d] != kUnset) {
+                continue;
+            }
+            std::size_t best = 0;
+            std::pair<std::size_t, std::size_t> best_score{};
+            for (std::size_t v = 0; v < sizes_[d]; ++v) {
+                row[d] = v;
+                std::pair score{Gain(interactions, uncovered, row, d), open[first_value[d] + v]};
+                if (v == 0 || score > best_score) {
+                    best = v;
+                    best_score = score;
+                }
+            }
+            row[d] = best;
+        }
+    }
+
+    // Fixes the dimensions of subset `s` in `row` to its first uncovered combination.
+    void Seed(const InteractionSet& interactions, const std::vector<bool>& uncovered,
+              std::size_t s, std::vector<std::size_t>& row) const {
+        auto first = interactions.offsets[s];
+        while (!uncovered[first]) {
+            ++first;
+        }
+        auto index = first - interactions.offsets[s];
+        const auto& subset = interactions.subsets[s];
+        for (auto i = subset.size(); i > 0; --i) {
+            row[subset[i - 1]] = index % sizes_[subset[i - 1]];
+            index /= sizes_[subset[i - 1]];
+        }
+    }
+
+    // Uncovered combinations that `row` would cover among the subsets containing
+    // `dimension` whose other dimensions are already set.
+    static auto Gain(const InteractionSet& interactions, const std::vector<bool>& uncovered,
+                     const std::vector<std::size_t>& row, std::size_t dimension)
+        -> std::size_t {
+        std::size_t gain = 0;
+        for (std::size_t s = 0; s < interactions.subsets.size(); ++s) {
+            const auto& subset = interactions.subsets[s];
+            auto contains = false;
+            auto complete = true;
+            for (auto d : subset) {
+                contains = contains || d == dimension;
+                complete = complete && row[d] != kUnset;
+            }
+            if (contains && complete && uncovered[interactions.Index(s, row)]) {
+                ++gain;
+            }
+        }
+        return gain;
+    }
+};
+
+// The cases of a parameter matrix: each is a std::tuple with one value per dimension,
+// taken from the rows of a CombinationTable. Values and table are shared by copies.
+template <typename... Ts>
+class MatrixCases {
+   public:
+    MatrixCases(CombinationTable table, std::vector<Ts>... dimensions)
+        : values_(std::make_shared<const std::tuple<std::vector<Ts>...>>(
+              std::move(dimensions)...)),
+          table_(std::make_shared<const CombinationTable>(std::move(table))) {}
+
+    [[nodiscard]] auto size() const -> std::size_t {  // NOLINT(readability-identifier-naming)
+        return table_->size();
+    }
+
+    auto operator[](std::size_t i) const -> std::tuple<Ts...> {
+        return Row(i, std::index_sequence_for<Ts...>{});
+    }
+
+    [[nodiscard]] auto Table() const -> const std::shared_ptr<const CombinationTable>& {
+        return table_;
+    }
+
+   private:
+    std::shared_ptr<const std::tuple<std::vector<Ts>...>> values_;
+    std::shared_ptr<const CombinationTable> table_;
+
+    template <std::size_t... D>
+    auto Row(std::size_t i, std::index_sequence<D...> /*dimensions*/) const
+        -> std::tuple<Ts...> {
+        return {std::get<D>(*values_)[table_->Value(i, D)]...};
+    }
+};
+
+// Every combination of the values of `dimensions`, last dimension varying fastest.
+template <typename... Ts>
+auto ProductCases(std::vector<Ts>... dimensions) -> MatrixCases<Ts...> {
+    return {CombinationTable::Product({dimensions.size()...}), std::move(dimensions)...};
+}
+
+// A covering array of `strength` over `dimensions`: every combination of values of any
+// `strength` dimensions appears in at least one case, usually in far fewer cases than
+// the full product. Throws std::invalid_argument for a strength of 0 or an empty
+// dimension.
+template <typename... Ts>
+auto CoveringCases(std::size_t strength, std::vector<Ts>... dimensions) -> MatrixCases<Ts...> {
+    return {CombinationTable::Covering({dimensions.size()...}, strength),
+            std::move(dimensions)...};
+}
+
+// A covering array of strength 2: every pair of values of any two dimensions appears in
+// at least one case.
+template <typename... Ts>
+auto PairwiseCases(std::vector<Ts>... dimensions) -> MatrixCases<Ts...> {
+    return CoveringCases(2, std::move(dimensions)...);
+}
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_MATRIX_HPP_
@@ -0,0 +1,128 @@
+#ifndef FLUL_TEST_MEMORY_LIMIT_HPP_
+#define FLUL_TEST_MEMORY_LIMIT_HPP_
+
+#include <sys/resource.h>
+
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace flul::test {
+
+// Reads the number after "Key:" in /proc/self/status ("Threads:  4" -> 4). A missing or
+// malformed field reads as unavailable.
+inline auto ReadProcStatusField(std::string_view key) -> std::optional<std::size_t> {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.starts_with(key) && line.size() > key.size() && line[key.size()] == ':') {
+            auto first = line.find_first_not_of(" \t", key.size() + 1);
+            if (first == std::string::npos) {
+                return std::nullopt;
+            }
+            std::size_t value = 0;
+            const auto* end = line.data() + line.size();
+            if (std::from_chars(line.data() + first, end, value).ec != std::errc{}) {
+                return std::nullopt;
+            }
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+// Reads a "Key:   1234 kB" line from /proc/self/status and returns the value in bytes.
+inline auto ReadProcStatus(std::string_view key) -> std::optional<std::size_t> {
+    auto kib = ReadProcStatusField(key);
+    if (!kib) {
+        return std::nullopt;
+    }
+    return *kib * 1024;
+}
+
+// Caps how much additional data memory the current process may map while the object is
+// alive, and records whether the cap was hit.
+//
+// The cap is enforced with RLIMIT_DATA relative to the current VmData, so memory the
+// process already holds (the registry, shared result regions) does not count against the
+// test. Hitting the cap is detected through a new-handler: operator new calls it once
+// before throwing std::bad_alloc, even when the test later catches the exception.
+// The reported peak is the resident set of the whole process (VmHWM, reset on entry;
+// Linux only), not the data segment the cap applies to: Linux keeps no VmData high-water.
+class MemoryLimit {
+    std::size_t limit_;
+    rlimit saved_{};
+    std::new_handler saved_handler_ = nullptr;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    static inline std::atomic<bool> exhausted_{false};
+
+   public:
+    explicit MemoryLimit(std::size_t limit) : limit_(limit) {
+        if (limit_ == 0) {
+            return;
+        }
+        exhausted_.store(false, std::memory_order_relaxed);
+        ResetPeak();
+
+        ::getrlimit(RLIMIT_DATA, &saved_);
+        if (auto base = ReadProcStatus("VmData")) {
+            rlimit capped = saved_;
+            capped.rlim_cur = *base + limit_;
+            if (saved_.rlim_max != RLIM_INFINITY && capped.rlim_cur > saved_.rlim_max) {
+                capped.rlim_cur = saved_.rlim_max;
+            }
+            ::setrlimit(RLIMIT_DATA, &capped);
+        }
+        saved_handler_ = std::set_new_handler(&OnExhausted);
+    }
+
+    MemoryLimit(const MemoryLimit&) = delete;
+    auto operator=(const MemoryLimit&) -> MemoryLimit& = delete;
+    MemoryLimit(MemoryLimit&&) = delete;
+    auto operator=(MemoryLimit&&) -> MemoryLimit& = delete;
+
+    ~MemoryLimit() {
+        if (limit_ == 0) {
+            return;
+        }
+        std::set_new_handler(saved_handler_);
+        ::setrlimit(RLIMIT_DATA, &saved_);
+    }
+
+    [[nodiscard]] auto Limit() const -> std::size_t {
+        return limit_;
+    }
+
+    [[nodiscard]] auto Exceeded() const -> bool {
+        return limit_ != 0 && exhausted_.load(std::memory_order_relaxed);
+    }
+
+    // Peak resident set size of the process since construction, in bytes; 0 if
+    // unavailable.
+    [[nodiscard]] static auto PeakResident() -> std::size_t {
+        return ReadProcStatus("VmHWM").value_or(0);
+    }
+
+   private:
+    static void OnExhausted() {
+        exhausted_.store(true, std::memory_order_relaxed);
+        // Let the pending allocation fail with std::bad_alloc.
+        std::set_new_handler(nullptr);
+    }
+
+    // Writing "5" to clear_refs resets the VmHWM high-water mark (Linux >= 4.0).
+    static void ResetPeak() {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        clear_refs << "5";
+    }
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_MEMORY_LIMIT_HPP_
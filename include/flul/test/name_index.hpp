@@ -0,0 +1,95 @@
+#ifndef FLUL_TEST_NAME_INDEX_HPP_
+#define FLUL_TEST_NAME_INDEX_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "flul/test/test_entry.hpp"
+
+namespace flul::test {
+
+// Whether `suite`::`test` is `full_name`, without formatting the joined name.
+inline auto HasFullName(std::string_view suite, std::string_view test, std::string_view full_name)
+    -> bool {
+    return full_name.size() == suite.size() + 2 + test.size() && full_name.starts_with(suite) &&
+           full_name.substr(suite.size(), 2) == "::" && full_name.ends_with(test);
+}
+
+inline auto HasFullName(const TestEntry& test, std::string_view full_name) -> bool {
+    return HasFullName(test.suite_name, test.test_name, full_name);
+}
+
+// Exact lookup of tests by full name "Suite::Test".
+//
+// An open-addressing hash table of indices into a test span, built once in O(N). Names
+// are hashed and compared piecewise — suite, "::", test — so neither building the index
+// nor probing it formats a joined name. When two tests share a name, the first one
+// registered is found.
+class NameIndex {
+   public:
+    explicit NameIndex(std::span<const TestEntry> tests)
+        : tests_(tests),
+          slots_(std::bit_ceil(std::max<std::size_t>(2 * tests.size(), 8)), kEmpty) {
+        for (std::uint32_t i = 0; i < tests.size(); ++i) {
+            const auto& test = tests[i];
+            for (auto slot = Home(Hash({test.suite_name, "::", test.test_name}));;
+                 slot = Next(slot)) {
+                if (slots_[slot] == kEmpty) {
+                    slots_[slot] = i;
+                    break;
+                }
+                const auto& other = tests[slots_[slot]];
+                if (other.suite_name == test.suite_name && other.test_name == test.test_name) {
+                    break;  // duplicate name; keep the first
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] auto Find(std::string_view full_name) const -> std::optional<std::uint32_t> {
+        for (auto slot = Home(Hash({full_name})); slots_[slot] != kEmpty; slot = Next(slot)) {
+            if (HasFullName(tests_[slots_[slot]], full_name)) {
+                return slots_[slot];
+            }
+        }
+        return std::nullopt;
+    }
+
+   private:
+    static constexpr std::uint32_t kEmpty = std::numeric_limits<std::uint32_t>::max();
+
+    std::span<const TestEntry> tests_;
+    std::vector<std::uint32_t> slots_;  // power-of-two sized, at most half full
+
+    // FNV-1a over the concatenation of `parts`.
+    static auto Hash(std::initializer_list<std::string_view> parts) -> std::uint64_t {
+        std::uint64_t hash = 0xcbf29ce484222325;
+        for (auto part : parts) {
+            for (auto c : part) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+            }
+        }
+        return hash;
+    }
+
+    [[nodiscard]] auto Home(std::uint64_t hash) const -> std::size_t {
+        // FNV's low bits mix poorly for short keys; fold the high half in.
+        return (hash ^ (hash >> 32U)) & (slots_.size() - 1);
+    }
+
+    [[nodiscard]] auto Next(std::size_t slot) const -> std::size_t {
+        return (slot + 1) & (slots_.size() - 1);
+    }
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_NAME_INDEX_HPP_
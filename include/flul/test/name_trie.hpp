@@ -0,0 +1,195 @@
+#ifndef FLUL_TEST_NAME_TRIE_HPP_
+#define FLUL_TEST_NAME_TRIE_HPP_
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <optional>
+#include <print>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace flul::test {
+
+// Anything named like a test: TestEntry and TestResult both qualify.
+template <typename T>
+concept TestNamed = requires(const T& item) {
+    { item.suite_name } -> std::convertible_to<std::string_view>;
+    { item.test_name } -> std::convertible_to<std::string_view>;
+};
+
+// Whether `name` is the group `group` or lies inside it: "Storage::Btree" is in
+// "Storage", "Storage::Btrees" is not.
+inline auto InGroup(std::string_view name, std::string_view group) -> bool {
+    return name.starts_with(group) &&
+           (name.size() == group.size() || name.substr(group.size()).starts_with("::"));
+}
+
+// Prefix trie over hierarchical test names.
+//
+// A full name "Storage::Btree::Insert::Concurrent" is split at every "::" — in the suite
+// name as well as the test name — so nested groups form a tree: Storage > Btree > Insert,
+// with the test at the leaf. Each node counts the tests in its subtree. Labels are views
+// into the indexed names, which must outlive the trie.
+class NameTrie {
+   public:
+    static constexpr std::uint32_t kRoot = 0;
+
+    struct Node {
+        std::string_view label;
+        std::uint32_t parent;
+        std::vector<std::uint32_t> children{};  // in order of first registration
+        std::vector<std::uint32_t> tests{};     // indices of the tests named by this path
+        std::size_t count = 0;                  // tests in the subtree
+    };
+
+    template <std::ranges::random_access_range R>
+        requires TestNamed<std::ranges::range_value_t<R>>
+    explicit NameTrie(const R& items) : nodes_(1, Node{.label = {}, .parent = kRoot}) {
+        for (std::uint32_t i = 0; i < std::ranges::size(items); ++i) {
+            const auto& item = items[i];
+            auto node = kRoot;
+            ++nodes_[kRoot].count;
+            auto descend = [&](std::string_view label) {
+                node = Child(node, label);
+                ++nodes_[node].count;
+            };
+            ForEachComponent(item.suite_name, descend);
+            ForEachComponent(item.test_name, descend);
+            nodes_[node].tests.push_back(i);
+        }
+    }
+
+    [[nodiscard]] auto Nodes() const -> std::span<const Node> {
+        return nodes_;
+    }
+
+    // The node for a "::"-separated group path such as "Storage::Btree"; "" is the root.
+    [[nodiscard]] auto Find(std::string_view path) const -> std::optional<std::uint32_t> {
+        std::optional<std::uint32_t> node = kRoot;
+        ForEachComponent(path, [&](std::string_view label) {
+            if (node) {
+                auto it = edges_.find({*node, label});
+                node = it == edges_.end() ? std::nullopt : std::optional(it->second);
+            }
+        });
+        return node;
+    }
+
+    // Indices of every test under `node`, in ascending order.
+    [[nodiscard]] auto Subtree(std::uint32_t node) const -> std::vector<std::uint32_t> {
+        std::vector<std::uint32_t> tests;
+        tests.reserve(nodes_[node].count);
+        std::vector<std::uint32_t> pending{node};
+        while (!pending.empty()) {
+            const auto& n = nodes_[pending.back()];
+            pending.pop_back();
+            tests.insert(tests.end(), n.tests.begin(), n.tests.end());
+            pending.insert(pending.end(), n.children.begin(), n.children.end());
+        }
+        std::ranges::sort(tests);
+        return tests;
+    }
+
+    // The "::"-joined path from the root to `node`.
+    [[nodiscard]] auto Path(std::uint32_t node) const -> std::string {
+        std::vector<std::string_view> labels;
+        for (; node != kRoot; node = nodes_[node].parent) {
+            labels.push_back(nodes_[node].label);
+        }
+        std::string path;
+        for (auto it = labels.rbegin(); it != labels.rend(); ++it) {
+            path += path.empty() ? "" : "::";
+            path += *it;
+        }
+        return path;
+    }
+
+    // Sums per-test values over every subtree: result[n] is the total for node n.
+    template <typename V>
+    [[nodiscard]] auto Rollup(std::span<const V> values) const -> std::vector<V> {
+        std::vector<V> totals(nodes_.size(), V{});
+        // Children are always created after their parent, so a reverse sweep finishes
+        // every child before adding it to its parent.
+        for (auto n = nodes_.size(); n-- > 0;) {
+            for (auto test : nodes_[n].tests) {
+                totals[n] += values[test];
+            }
+            if (n != kRoot) {
+                totals[nodes_[n].parent] += totals[n];
+            }
+        }
+        return totals;
+    }
+
+    // Prints the tree below the root, two spaces per level. Groups show their test count;
+    // a leaf naming a single test is printed bare.
+    void Print(std::FILE* stream) const {
+        std::vector<std::pair<std::uint32_t, std::size_t>> pending;  // node, depth
+        for (auto child : nodes_[kRoot].children | std::views::reverse) {
+            pending.emplace_back(child, 0);
+        }
+        while (!pending.empty()) {
+            auto [node, depth] = pending.back();
+            pending.pop_back();
+            const auto& n = nodes_[node];
+            if (n.children.empty() && n.count == 1) {
+                std::println(stream, "{:{}}{}", "", depth * 2, n.label);
+            } else {
+                std::println(stream, "{:{}}{} ({})", "", depth * 2, n.label, n.count);
+            }
+            for (auto child : n.children | std::views::reverse) {
+                pending.emplace_back(child, depth + 1);
+            }
+        }
+    }
+
+   private:
+    struct Edge {
+        std::uint32_t parent;
+        std::string_view label;
+
+        auto operator==(const Edge&) const -> bool = default;
+    };
+
+    struct EdgeHash {
+        auto operator()(const Edge& edge) const -> std::size_t {
+            return std::hash<std::string_view>{}(edge.label) ^
+                   (std::hash<std::uint32_t>{}(edge.parent) * 0x9e3779b97f4a7c15);
+        }
+    };
+
+    std::vector<Node> nodes_;
+    std::unordered_map<Edge, std::uint32_t, EdgeHash> edges_;  // (parent, label) -> child
+
+    template <typename F>
+    static void ForEachComponent(std::string_view path, F visit) {
+        while (!path.empty()) {
+            auto end = path.find("::");
+            visit(path.substr(0, end));
+            path = end == std::string_view::npos ? std::string_view() : path.substr(end + 2);
+        }
+    }
+
+    auto Child(std::uint32_t parent, std::string_view label) -> std::uint32_t {
+        auto [it, inserted] =
+            edges_.try_emplace({parent, label}, static_cast<std::uint32_t>(nodes_.size()));
+        if (inserted) {
+            nodes_.push_back({.label = label, .parent = parent});
+            nodes_[parent].children.push_back(it->second);
+        }
+        return it->second;
+    }
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_NAME_TRIE_HPP_
@@ -0,0 +1,244 @@
+#ifndef FLUL_TEST_OUTPUT_CAPTURE_HPP_
+#define FLUL_TEST_OUTPUT_CAPTURE_HPP_
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace flul::test {
+
+// Redirects the process-wide stdout and stderr file descriptors into a pipe between
+// Start() and Finish(). One reader thread drains the pipe for the lifetime of the
+// capture and keeps at most `limit` bytes per test, counting the rest as truncated, so
+// memory stays bounded however much a test prints. One capture serves every test of a
+// run: a test costs four dup2 calls and one round trip to the reader, and Finish() never
+// waits for EOF, so a child process that inherits the descriptors cannot hang it.
+// Captures nest: a capture restores the descriptors that were current when it was
+// constructed.
+class OutputCapture {
+    int saved_stdout_ = -1;
+    int saved_stderr_ = -1;
+    int data_read_ = -1;   // non-blocking, so the reader can drain it dry
+    int data_write_ = -1;
+    int wake_read_ = -1;   // one byte per request: 's' to settle, 'q' to quit
+    int wake_write_ = -1;
+    std::size_t limit_;
+    bool active_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable settled_;
+    std::string buffer_;            // guarded by mutex_
+    std::size_t dropped_ = 0;       // guarded by mutex_
+    std::uint64_t requested_ = 0;   // guarded by mutex_
+    std::uint64_t served_ = 0;      // guarded by mutex_
+    bool stopped_ = false;          // guarded by mutex_
+    std::thread reader_;
+
+   public:
+    // Opens the pipes, starts the reader and, unless `start` is false, starts capturing.
+    explicit OutputCapture(std::size_t limit, bool start = true) : limit_(limit) {
+        try {
+            OpenPipe(data_read_, data_write_);
+            OpenPipe(wake_read_, wake_write_);
+            if (::fcntl(data_read_, F_SETFL, ::fcntl(data_read_, F_GETFL) | O_NONBLOCK) < 0) {
+                throw std::system_error(errno, std::generic_category(), "fcntl");
+            }
+            saved_stdout_ = ::dup(STDOUT_FILENO);
+            saved_stderr_ = ::dup(STDERR_FILENO);
+            if (saved_stdout_ < 0 || saved_stderr_ < 0) {
+                throw std::system_error(errno, std::generic_category(), "dup");
+            }
+            reader_ = std::thread([this] { Read(); });
+            if (start) {
+                Start();
+            }
+        } catch (...) {
+            Stop();
+            throw;
+        }
+    }
+
+    OutputCapture(const OutputCapture&) = delete;
+    auto operator=(const OutputCapture&) -> OutputCapture& = delete;
+    OutputCapture(OutputCapture&&) = delete;
+    auto operator=(OutputCapture&&) -> OutputCapture& = delete;
+
+    ~OutputCapture() {
+        if (active_) {
+            std::fflush(stdout);
+            std::fflush(stderr);
+            ::dup2(saved_stdout_, STDOUT_FILENO);
+            ::dup2(saved_stderr_, STDERR_FILENO);
+        }
+        Stop();
+    }
+
+    // Starts capturing. Bytes that arrived since the last Finish(), e.g. from a child
+    // process that outlived its test, are discarded.
+    void Start() {
+        if (active_) {
+            return;
+        }
+        {
+            std::scoped_lock lock(mutex_);
+            buffer_.clear();
+            dropped_ = 0;
+        }
+        std::fflush(stdout);
+        std::fflush(stderr);
+        Redirect(data_write_, data_write_, saved_stdout_);
+        active_ = true;
+    }
+
+    // Restores the original descriptors and returns everything captured since Start().
+    // A truncation marker is appended when the limit was exceeded.
+    auto Finish() -> std::string {
+        if (!active_) {
+            return {};
+        }
+        std::fflush(stdout);
+        std::fflush(stderr);
+        Redirect(saved_stdout_, saved_stderr_, data_write_);
+        active_ = false;
+
+        // Every byte written before the restore is already in the pipe; the reader
+        // drains it before it answers the request.
+        std::unique_lock lock(mutex_);
+        auto ticket = ++requested_;
+        lock.unlock();
+        WriteWake('s');
+        lock.lock();
+        settled_.wait(lock, [&] { return served_ >= ticket || stopped_; });
+
+        auto text = std::move(buffer_);
+        buffer_.clear();
+        if (dropped_ > 0) {
+            text += std::format("\n[... {} bytes truncated]\n", dropped_);
+        }
+        dropped_ = 0;
+        return text;
+    }
+
+   private:
+    static void OpenPipe(int& read_end, int& write_end) {
+        std::array<int, 2> fds{};
+        if (::pipe(fds.data()) != 0) {
+            throw std::system_error(errno, std::generic_category(), "pipe");
+        }
+        read_end = fds[0];
+        write_end = fds[1];
+        for (int fd : fds) {
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+    }
+
+    // Points stdout at `out` and stderr at `err`. If stderr cannot be redirected, stdout
+    // is pointed back at `undo` so the two never diverge.
+    static void Redirect(int out, int err, int undo) {
+        if (::dup2(out, STDOUT_FILENO) < 0) {
+            throw std::system_error(errno, std::generic_category(), "dup2");
+        }
+        if (::dup2(err, STDERR_FILENO) < 0) {
+            auto error = errno;
+            ::dup2(undo, STDOUT_FILENO);
+            throw std::system_error(error, std::generic_category(), "dup2");
+        }
+    }
+
+    void WriteWake(char request) const {
+        while (::write(wake_write_, &request, 1) < 0 && errno == EINTR) {
+        }
+    }
+
+    // The reader thread: keeps the data pipe empty and answers wake requests.
+    void Read() {
+        std::array<pollfd, 2> fds{{
+            {.fd = data_read_, .events = POLLIN, .revents = 0},
+            {.fd = wake_read_, .events = POLLIN, .revents = 0},
+        }};
+        for (;;) {
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            if (fds[0].revents != 0) {
+                Drain();
+            }
+            if (fds[1].revents == 0) {
+                continue;
+            }
+            char request = 0;
+            auto n = ::read(wake_read_, &request, 1);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            Drain();
+            if (n <= 0 || request == 'q') {
+                break;
+            }
+            {
+                std::scoped_lock lock(mutex_);
+                ++served_;
+            }
+            settled_.notify_all();
+        }
+        {
+            std::scoped_lock lock(mutex_);
+            stopped_ = true;
+        }
+        settled_.notify_all();
+    }
+
+    // Reads until the pipe is empty, keeping bytes up to the limit and counting the rest.
+    void Drain() {
+        std::array<char, 4096> chunk{};
+        for (;;) {
+            auto n = ::read(data_read_, chunk.data(), chunk.size());
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return;
+            }
+            auto size = static_cast<std::size_t>(n);
+            std::scoped_lock lock(mutex_);
+            auto keep = std::min(size, limit_ - std::min(limit_, buffer_.size()));
+            buffer_.append(chunk.data(), keep);
+            dropped_ += size - keep;
+        }
+    }
+
+    void Stop() noexcept {
+        if (reader_.joinable()) {
+            WriteWake('q');
+            reader_.join();
+        }
+        for (int* fd : {&saved_stdout_, &saved_stderr_, &data_read_, &data_write_, &wake_read_,
+                        &wake_write_}) {
+            if (*fd >= 0) {
+                ::close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_OUTPUT_CAPTURE_HPP_
@@ -0,0 +1,640 @@
+#ifndef FLUL_TEST_PROCESS_POOL_HPP_
+#define FLUL_TEST_PROCESS_POOL_HPP_
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <optional>
+#include <print>
+#include <source_location>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "flul/test/assertion_error.hpp"
+#include "flul/test/dependencies.hpp"
+#include "flul/test/test_entry.hpp"
+#include "flul/test/test_result.hpp"
+#include "flul/test/work_queue.hpp"
+#include "flul/test/worker_tuner.hpp"
+
+namespace flul::test {
+
+// Per-test bookkeeping shared between the coordinator and the workers.
+struct SlotState {
+    enum : std::uint32_t { kQueued = 0, kClaimed, kRunning, kDone };
+
+    std::atomic<std::uint32_t> state;
+    std::atomic<std::int32_t> owner;       // pid of the worker that claimed the test
+    std::atomic<std::int64_t> started_ns;  // steady_clock time the test started
+};
+
+// Result of one test as written by a worker. Trivially default-constructible so that the
+// shared array costs no memory until a record is written. The variable-length part is
+// appended to the worker's text file at `text_offset`, so a record stays a few dozen
+// bytes however much a test prints or how often it fails: each stored failure as its
+// source_location, the sizes of actual and expected, and the two strings, followed by
+// the captured output. std::source_location is trivially copyable and only refers to
+// static data of the binary, which is mapped at the same address in every forked worker.
+struct SharedRecord {
+    bool passed;
+    std::uint32_t failures;  // stored: the first failure, then more_failures
+    std::uint64_t unstored_failures;
+    std::int64_t duration_ns;
+    std::int64_t simulated_ns;
+    std::uint64_t peak_memory;
+    std::uint64_t text_offset;
+    std::uint64_t text_size;
+};
+
+// Runs tests in N forked worker processes that claim work from a shared WorkQueue.
+// Workers claim consecutive tests in batches sized by a BatchSizer, so sub-microsecond
+// tests do not pay one queue operation and one notification each; every test still
+// gets its own slot, record and timing.
+//
+// The coordinator (the process calling Run) pushes test indices, then waits for
+// completion notices on a pipe and reports each result as it arrives. A worker that dies
+// mid-test gets that test reported as a crash; tests it had claimed but not started are
+// put back in the queue and a replacement worker is spawned.
+//
+// Tests with prerequisites are only pushed once all of them have passed, so independent
+// branches of the dependency DAG run in parallel; the queue stays open until every test
+// has been pushed or skipped.
+//
+// With a WorkerTuner the worker count changes at runtime: every kTuneInterval the
+// coordinator feeds throughput, CPU utilization and load average to the tuner, spawns
+// workers when it grows and asks idle workers to retire when it shrinks. Decisions are
+// logged to stderr.
+class ProcessPool {
+    static constexpr std::chrono::milliseconds kTuneInterval{250};
+    static_assert(BatchSizer::kMaxBatch * sizeof(std::uint32_t) <= PIPE_BUF);
+
+    std::span<const TestEntry> tests_;
+    WorkerTuner* tuner_;
+    std::size_t desired_;
+    WorkQueue queue_;
+    SharedArray<SlotState> slots_;
+    SharedArray<SharedRecord> records_;
+    SharedArray<std::atomic<std::uint32_t>> retire_{1};  // workers asked to exit
+    DependencyTracker graph_;
+    std::vector<bool> released_;  // pushed to the queue at least once
+    std::vector<bool> reported_;
+    // A live worker and the in-memory file it appends result text to. The coordinator
+    // preads the file, frees what it has read, and closes it once the worker is reaped.
+    struct Worker {
+        pid_t pid;
+        int text;
+        std::uint64_t read = 0;  // coordinator side: text before this offset was loaded
+    };
+    std::vector<Worker> workers_;
+    std::uint64_t text_end_ = 0;  // worker side: bytes appended to its text file
+    std::size_t unreleased_;  // neither pushed nor skipped yet
+    std::size_t remaining_;
+    int notify_read_ = -1;
+    int notify_write_ = -1;
+
+    // Tuning interval state, coordinator only.
+    std::chrono::steady_clock::time_point interval_start_{};
+    std::size_t interval_remaining_ = 0;
+    std::optional<CpuTimes> interval_cpu_;
+
+   public:
+    ProcessPool(std::span<const TestEntry> tests, std::size_t workers,
+                WorkerTuner* tuner = nullptr,
+                std::span<const std::vector<std::uint32_t>> prerequisites = {})
+        : tests_(tests),
+          tuner_(tuner),
+          desired_(std::max<std::size_t>(
+              1, std::min(tuner != nullptr ? tuner->Workers() : workers, tests.size()))),
+          queue_(tests.size()),
+          slots_(tests.size()),
+          records_(tests.size()),
+          graph_(tests.size(), prerequisites),
+          released_(tests.size(), false),
+          reported_(tests.size(), false),
+          unreleased_(tests.size()),
+          remaining_(tests.size()) {}
+
+    ProcessPool(const ProcessPool&) = delete;
+    auto operator=(const ProcessPool&) -> ProcessPool& = delete;
+    ProcessPool(ProcessPool&&) = delete;
+    auto operator=(ProcessPool&&) -> ProcessPool& = delete;
+
+    ~ProcessPool() {
+        for (int fd : {notify_read_, notify_write_}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+        for (const auto& worker : workers_) {
+            ::close(worker.text);
+        }
+    }
+
+    // `run_test(const TestEntry&) -> TestResult` executes in the workers;
+    // `report(TestResult)` is called in the coordinator, once per test.
+    template <typename RunFn, typename ReportFn>
+    void Run(RunFn run_test, ReportFn report) {
+        if (tests_.empty()) {
+            return;
+        }
+
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            throw std::system_error(errno, std::generic_category(), "pipe");
+        }
+        notify_read_ = fds[0];
+        notify_write_ = fds[1];
+        ::fcntl(notify_read_, F_SETFL, ::fcntl(notify_read_, F_GETFL) | O_NONBLOCK);
+
+        for (auto index : graph_.Initial()) {
+            Release(index);
+        }
+        StartInterval();
+
+        while (remaining_ > 0) {
+            while (workers_.size() < desired_ && queue_.Size() > 0) {
+                Spawn(run_test);
+            }
+            WaitForNotifications(report);
+            ReapWorkers(report);
+            if (workers_.empty() && remaining_ > 0 && queue_.Size() == 0) {
+                RequeueLost();
+            }
+            if (tuner_ != nullptr) {
+                Tune();
+            }
+        }
+
+        for (const auto& worker : workers_) {
+            int status = 0;
+            while (::waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {
+            }
+            ::close(worker.text);
+        }
+        workers_.clear();
+    }
+
+   private:
+    template <typename RunFn>
+    void Spawn(RunFn& run_test) {
+        int text = ::memfd_create("flul-results", MFD_CLOEXEC);
+        if (text < 0) {
+            throw std::system_error(errno, std::generic_category(), "memfd_create");
+        }
+        std::fflush(stdout);
+        std::fflush(stderr);
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            auto error = errno;
+            ::close(text);
+            throw std::system_error(error, std::generic_category(), "fork");
+        }
+        if (pid == 0) {
+            WorkerMain(run_test, text);
+        }
+        workers_.push_back({.pid = pid, .text = text});
+    }
+
+    // Never returns: the worker runs on a copy of the coordinator's stack, so neither an
+    // exception nor the parent's atexit handlers and stdio buffers may escape into it. A
+    // test that cannot be run — its capture or memory limit failed to set up — is
+    // recorded as a failure and ends the worker; the rest of its batch is requeued.
+    template <typename RunFn>
+    [[noreturn]] void WorkerMain(RunFn& run_test, int text) {
+        using namespace std::chrono;  // NOLINT(google-build-using-namespace)
+
+        ::close(notify_read_);
+        for (const auto& worker : workers_) {
+            ::close(worker.text);
+        }
+        text_end_ = 0;
+        std::int32_t self = ::getpid();
+        std::array<std::uint32_t, BatchSizer::kMaxBatch> claim{};
+        BatchSizer sizer;
+
+        std::optional<std::uint32_t> current;
+        try {
+            while (!Retire()) {
+                auto want = sizer.Next(queue_.Size(), desired_);
+                auto count = queue_.Claim(std::span(claim).first(want));
+                if (count == 0) {
+                    if (queue_.Closed() && queue_.Size() == 0) {
+                        break;
+                    }
+                    std::this_thread::sleep_for(100us);
+                    continue;
+                }
+                auto batch = std::span(claim).first(count);
+                for (auto index : batch) {
+                    slots_[index].owner.store(self, std::memory_order_relaxed);
+                    slots_[index].state.store(SlotState::kClaimed, std::memory_order_release);
+                }
+                for (auto index : batch) {
+                    auto& slot = slots_[index];
+                    slot.started_ns.store(steady_clock::now().time_since_epoch().count(),
+                                          std::memory_order_relaxed);
+                    slot.state.store(SlotState::kRunning, std::memory_order_release);
+                    current = index;
+                    auto result = run_test(tests_[index]);
+                    sizer.Observe(result.duration);
+                    Store(result, records_[index], text);
+                    slot.state.store(SlotState::kDone, std::memory_order_release);
+                    current.reset();
+                }
+                // One notice for the whole batch; at most 256 bytes, so the write is
+                // atomic. Should the worker die half-way, Attribute() reports the
+                // finished slots.
+                [[maybe_unused]] auto written =
+                    ::write(notify_write_, batch.data(), batch.size_bytes());
+            }
+        } catch (...) {
+            if (current) {
+                FailInWorker(*current, std::current_exception(), text);
+            }
+            ::_exit(1);
+        }
+        ::_exit(0);
+    }
+
+    // Worker side: records `error`, thrown while running test `index`, as its result and
+    // notifies the coordinator. Without a record the slot stays running and the test is
+    // reported as a crash when the worker exits.
+    void FailInWorker(std::uint32_t index, const std::exception_ptr& error, int text) noexcept {
+        try {
+            std::string what = "non-standard exception";
+            try {
+                std::rethrow_exception(error);
+            } catch (const std::exception& e) {
+                what = e.what();
+            } catch (...) {  // NOLINT(bugprone-empty-catch): keeps the default text
+            }
+            auto loc = std::source_location::current();
+            TestResult result{.suite_name = tests_[index].suite_name,
+                              .test_name = tests_[index].test_name,
+                              .id = index,
+                              .passed = false,
+                              .duration = {},
+                              .error = AssertionError("worker could not run the test: " + what,
+                                                      "test to run", loc)};
+            Store(result, records_[index], text);
+            slots_[index].state.store(SlotState::kDone, std::memory_order_release);
+            [[maybe_unused]] auto written = ::write(notify_write_, &index, sizeof(index));
+        } catch (...) {  // NOLINT(bugprone-empty-catch): reported as a crash instead
+        }
+    }
+
+    // Worker side: consumes one pending retire request, if any.
+    auto Retire() -> bool {
+        auto& pending = retire_[0];
+        auto n = pending.load(std::memory_order_relaxed);
+        while (n > 0) {
+            if (pending.compare_exchange_weak(n, n - 1, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void StartInterval() {
+        interval_start_ = std::chrono::steady_clock::now();
+        interval_remaining_ = remaining_;
+        interval_cpu_ = ReadCpuTimes();
+    }
+
+    void Tune() {
+        using namespace std::chrono;  // NOLINT(google-build-using-namespace)
+
+        auto elapsed = steady_clock::now() - interval_start_;
+        if (elapsed < kTuneInterval) {
+            return;
+        }
+        // Once the queue runs dry throughput falls no matter what; stop tuning.
+        if (queue_.Size() < desired_) {
+            return;
+        }
+
+        auto cpu = ReadCpuTimes();
+        double load = 0;
+        ::getloadavg(&load, 1);
+        auto seconds = duration<double>(elapsed).count();
+        Observation obs{
+            .throughput = static_cast<double>(interval_remaining_ - remaining_) / seconds,
+            // Without /proc/stat, report saturation so idle CPUs never trigger growth.
+            .cpu = cpu && interval_cpu_ ? Utilization(*interval_cpu_, *cpu) : 1.0,
+            .load = load,
+        };
+        auto decision = tuner_->Update(obs);
+        StartInterval();
+        if (decision.reason.empty()) {
+            return;
+        }
+
+        std::println(stderr, "[ TUNE ] workers {} -> {}: {} ({:.1f} tests/s, load {:.1f})",
+                     desired_, decision.workers, decision.reason, obs.throughput, obs.load);
+        desired_ = std::max<std::size_t>(1, std::min(decision.workers, tests_.size()));
+        // Recompute outstanding retirements from scratch; while the counter is zero no
+        // worker can consume a request.
+        auto pending = static_cast<std::size_t>(retire_[0].exchange(0));
+        auto live = workers_.size() - std::min(pending, workers_.size());
+        if (desired_ < live) {
+            retire_[0].store(static_cast<std::uint32_t>(live - desired_));
+        }
+    }
+
+    template <typename ReportFn>
+    void WaitForNotifications(ReportFn& report) {
+        pollfd pfd{.fd = notify_read_, .events = POLLIN, .revents = 0};
+        if (::poll(&pfd, 1, 10) <= 0) {
+            return;
+        }
+        std::array<std::uint32_t, 256> indices{};
+        for (;;) {
+            auto n = ::read(notify_read_, indices.data(), sizeof(indices));
+            if (n <= 0) {
+                return;
+            }
+            // Every write is a whole number of 4-byte indices no larger than PIPE_BUF
+            // (atomic for pipes), so reads never split an index.
+            auto count = static_cast<std::size_t>(n) / sizeof(std::uint32_t);
+            for (auto index : std::span(indices).first(count)) {
+                Report(index, report);
+            }
+        }
+    }
+
+    template <typename ReportFn>
+    void ReapWorkers(ReportFn& report) {
+        std::erase_if(workers_, [&](const Worker& worker) {
+            int status = 0;
+            if (::waitpid(worker.pid, &status, WNOHANG) != worker.pid) {
+                return false;
+            }
+            Attribute(worker.pid, status, report);
+            ::close(worker.text);
+            return true;
+        });
+    }
+
+    // Settles every test the dead worker `pid` still owned.
+    template <typename ReportFn>
+    void Attribute(pid_t pid, int status, ReportFn& report) {
+        for (std::uint32_t i = 0; i < tests_.size(); ++i) {
+            auto& slot = slots_[i];
+            if (reported_[i] || slot.owner.load(std::memory_order_relaxed) != pid) {
+                continue;
+            }
+            switch (slot.state.load(std::memory_order_acquire)) {
+                case SlotState::kDone:
+                    Report(i, report);
+                    break;
+                case SlotState::kRunning:
+                    ReportCrash(i, status, report);
+                    break;
+                case SlotState::kClaimed:
+                    slot.state.store(SlotState::kQueued, std::memory_order_relaxed);
+                    queue_.Push(i);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    // Tests claimed by a worker that died before recording its claim are neither
+    // reported nor queued. Once every worker is gone, put them back.
+    void RequeueLost() {
+        for (std::uint32_t i = 0; i < tests_.size(); ++i) {
+            if (released_[i] && !reported_[i]) {
+                slots_[i].state.store(SlotState::kQueued, std::memory_order_relaxed);
+                queue_.Push(i);
+            }
+        }
+    }
+
+    void Release(std::uint32_t index) {
+        released_[index] = true;
+        queue_.Push(index);
+        if (--unreleased_ == 0) {
+            queue_.SetClosed(true);
+        }
+    }
+
+    template <typename ReportFn>
+    void Report(std::uint32_t index, ReportFn& report) {
+        if (index >= tests_.size() || reported_[index]) {
+            return;
+        }
+        auto result = Load(index);
+        Discard(index);
+        Settle(index, std::move(result), report);
+    }
+
+    // Frees the text of the loaded record `index`, so a long run keeps the text of the
+    // tests it has yet to report, not of every test. A worker appends its records in the
+    // order it notifies them, so the coordinator loads each file front to back and can
+    // free everything up to the end of the record. The hole starts at the page of the
+    // previous end, because only whole pages are returned to the system.
+    void Discard(std::uint32_t index) {
+        const auto& record = records_[index];
+        auto owner = slots_[index].owner.load(std::memory_order_relaxed);
+        auto worker = std::ranges::find(workers_, owner, &Worker::pid);
+        if (worker == workers_.end() || record.text_offset != worker->read) {
+            return;
+        }
+        static const auto kPage = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+        auto start = worker->read - (worker->read % kPage);
+        worker->read = record.text_offset + record.text_size;
+        if (worker->read - start >= kPage) {
+            ::fallocate(worker->text, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                        static_cast<off_t>(start), static_cast<off_t>(worker->read - start));
+        }
+    }
+
+    // Reports a finished test and releases or skips the tests that depend on it.
+    template <typename ReportFn>
+    void Settle(std::uint32_t index, TestResult result, ReportFn& report) {
+        reported_[index] = true;
+        --remaining_;
+        auto passed = result.passed;
+        report(std::move(result));
+
+        auto update = graph_.Complete(index, passed);
+        for (auto next : update.ready) {
+            Release(next);
+        }
+        for (auto skipped : update.skipped) {
+            reported_[skipped] = true;
+            --remaining_;
+            report(SkippedResult(tests_, skipped, index));
+            if (--unreleased_ == 0) {
+                queue_.SetClosed(true);
+            }
+        }
+    }
+
+    template <typename ReportFn>
+    void ReportCrash(std::uint32_t index, int status, ReportFn& report) {
+        using namespace std::chrono;  // NOLINT(google-build-using-namespace)
+
+        auto started = nanoseconds(slots_[index].started_ns.load(std::memory_order_relaxed));
+        auto duration = steady_clock::now().time_since_epoch() - started;
+        std::string actual =
+            WIFSIGNALED(status)
+                ? std::format("worker crashed: killed by signal {} ({})", WTERMSIG(status),
+                              ::strsignal(WTERMSIG(status)))  // NOLINT(concurrency-mt-unsafe)
+                : std::format("worker exited with code {} during the test", WEXITSTATUS(status));
+
+        auto loc = std::source_location::current();
+        Settle(index,
+               TestResult{.suite_name = tests_[index].suite_name,
+                          .test_name = tests_[index].test_name,
+                          .id = index,
+                          .passed = false,
+                          .duration = duration_cast<nanoseconds>(duration),
+                          .error = AssertionError(std::move(actual), "test to complete", loc)},
+               report);
+    }
+
+    // Worker side: fills `record` and appends the result's text to the worker's file.
+    void Store(const TestResult& result, SharedRecord& record, int text) {
+        std::string failures;
+        record.failures = 0;
+        if (result.error) {
+            AppendFailure(failures, *result.error);
+            for (const auto& failure : result.more_failures) {
+                AppendFailure(failures, failure);
+            }
+            record.failures = static_cast<std::uint32_t>(1 + result.more_failures.size());
+        }
+        record.passed = result.passed;
+        record.unstored_failures = result.unstored_failures;
+        record.duration_ns = result.duration.count();
+        record.simulated_ns = result.simulated.count();
+        record.peak_memory = result.peak_memory;
+        record.text_offset = text_end_;
+        record.text_size = Append(text, failures) + Append(text, result.output);
+    }
+
+    static void AppendFailure(std::string& text, const AssertionError& failure) {
+        const std::array<std::uint64_t, 2> sizes = {failure.actual.size(),
+                                                     failure.expected.size()};
+        auto header = text.size();
+        text.resize(header + sizeof(std::source_location) + sizeof(sizes));
+        std::memcpy(text.data() + header, &failure.location, sizeof(std::source_location));
+        std::memcpy(text.data() + header + sizeof(std::source_location), sizes.data(),
+                    sizeof(sizes));
+        text += failure.actual;
+        text += failure.expected;
+    }
+
+    // Coordinator side: the inverse of AppendFailure, consuming the failure from `text`.
+    // Null if the text is cut short.
+    static auto TakeFailure(std::string_view& text) -> std::optional<AssertionError> {
+        std::source_location loc;
+        std::array<std::uint64_t, 2> sizes{};
+        if (text.size() < sizeof(loc) + sizeof(sizes)) {
+            return std::nullopt;
+        }
+        std::memcpy(&loc, text.data(), sizeof(loc));
+        std::memcpy(sizes.data(), text.data() + sizeof(loc), sizeof(sizes));
+        text.remove_prefix(sizeof(loc) + sizeof(sizes));
+        if (sizes[0] > text.size() || sizes[1] > text.size() - sizes[0]) {
+            return std::nullopt;
+        }
+        std::string actual(text.substr(0, sizes[0]));
+        std::string expected(text.substr(sizes[0], sizes[1]));
+        text.remove_prefix(sizes[0] + sizes[1]);
+        return AssertionError(std::move(actual), std::move(expected), loc);
+    }
+
+    auto Append(int text, std::string_view data) -> std::uint64_t {
+        for (std::size_t done = 0; done < data.size();) {
+            auto n = ::write(text, data.data() + done, data.size() - done);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::system_error(errno, std::generic_category(), "write");
+            }
+            done += static_cast<std::size_t>(n);
+        }
+        text_end_ += data.size();
+        return data.size();
+    }
+
+    [[nodiscard]] auto Load(std::uint32_t index) const -> TestResult {
+        const auto& record = records_[index];
+        TestResult result{.suite_name = tests_[index].suite_name,
+                          .test_name = tests_[index].test_name,
+                          .id = index,
+                          .passed = record.passed,
+                          .duration = std::chrono::nanoseconds(record.duration_ns),
+                          .error = std::nullopt,
+                          .unstored_failures = static_cast<std::size_t>(record.unstored_failures),
+                          .simulated = std::chrono::nanoseconds(record.simulated_ns),
+                          .peak_memory = static_cast<std::size_t>(record.peak_memory)};
+
+        // The worker that wrote the record is still listed: it is only dropped after
+        // Attribute() has reported its finished tests.
+        auto owner = slots_[index].owner.load(std::memory_order_relaxed);
+        auto worker = std::ranges::find(workers_, owner, &Worker::pid);
+        auto data = ReadText(worker != workers_.end() ? worker->text : -1, record.text_offset,
+                             record.text_size);
+        std::string_view text = data;
+        for (std::uint32_t i = 0; i < record.failures; ++i) {
+            auto failure = TakeFailure(text);
+            if (!failure) {
+                break;
+            }
+            if (result.error) {
+                result.more_failures.push_back(std::move(*failure));
+            } else {
+                result.error = std::move(failure);
+            }
+        }
+        result.output = text;
+        return result;
+    }
+
+    static auto ReadText(int text, std::uint64_t offset, std::uint64_t size) -> std::string {
+        std::string value(size, '\0');
+        std::size_t done = 0;
+        while (text >= 0 && done < value.size()) {
+            auto n = ::pread(text, value.data() + done, value.size() - done,
+                             static_cast<off_t>(offset + done));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            done += static_cast<std::size_t>(n);
+        }
+        value.resize(done);
+        return value;
+    }
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_PROCESS_POOL_HPP_
@@ -0,0 +1,373 @@
+#ifndef FLUL_TEST_PROPERTY_HPP_
+#define FLUL_TEST_PROPERTY_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <source_location>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flul/test/assertion_error.hpp"
+#include "flul/test/soft_failures.hpp"
+#include "flul/test/stringify.hpp"
+
+namespace flul::test {
+
+// SplitMix64 (Steele, Lea and Flood): a tiny, fast generator whose outputs for
+// consecutive seeds are uncorrelated, so every property case gets its own stream.
+class SplitMix64 {
+   public:
+    static constexpr std::uint64_t kGamma = 0x9e3779b97f4a7c15;
+
+    constexpr explicit SplitMix64(std::uint64_t seed) : state_(seed) {}
+
+    constexpr auto Next() -> std::uint64_t {
+        auto z = state_ += kGamma;
+        z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27U)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31U);
+    }
+
+   private:
+    std::uint64_t state_;
+};
+
+// The choices a generator draws a value from.
+//
+// A fresh source draws random choices; a replaying source returns recorded ones. Either
+// way the choices actually used are recorded, so a failing input is fully described by
+// its choice sequence. Shrinking edits that sequence — dropping and lowering choices —
+// and replays the generator, which is why generators need no shrinking logic of their
+// own: they only have to map smaller choices to simpler values.
+class Source {
+   public:
+    explicit Source(std::uint64_t seed) : rng_(seed) {}
+    explicit Source(std::span<const std::uint64_t> replay) : replay_(replay), replaying_(true) {}
+
+    // A choice in [0, bound]. Replayed choices are clamped to the bound, and a replay
+    // that runs out of choices continues with zeros.
+    auto Draw(std::uint64_t bound) -> std::uint64_t {
+        std::uint64_t choice = 0;
+        if (replaying_) {
+            choice = used_.size() < replay_.size() ? std::min(replay_[used_.size()], bound) : 0;
+        } else {
+            auto raw = rng_.Next();
+            choice = bound == std::numeric_limits<std::uint64_t>::max() ? raw : raw % (bound + 1);
+        }
+        used_.push_back(choice);
+        return choice;
+    }
+
+    [[nodiscard]] auto Choices() const -> std::span<const std::uint64_t> {
+        return used_;
+    }
+
+   private:
+    SplitMix64 rng_{0};
+    std::span<const std::uint64_t> replay_;
+    bool replaying_ = false;
+    std::vector<std::uint64_t> used_;
+};
+
+// A generator is any callable producing a value from a Source. Build them from the
+// functions below and compose with Map, Tuples and VectorsOf.
+template <typename G>
+concept Generator = std::copy_constructible<G> && std::invocable<const G&, Source&> &&
+                    (!std::is_void_v<std::invoke_result_t<const G&, Source&>>);
+
+template <Generator G>
+using GeneratedType = std::remove_cvref_t<std::invoke_result_t<const G&, Source&>>;
+
+// Integers in [min, max], shrinking toward the value in that range nearest zero.
+template <std::integral T>
+    requires(!std::same_as<T, bool>)
+auto Integers(T min = std::numeric_limits<T>::min(), T max = std::numeric_limits<T>::max()) {
+    if (min > max) {
+        throw std::invalid_argument("Integers: min > max");
+    }
+    return [min, max](Source& source) -> T {
+        auto bits = [](T value) { return static_cast<std::uint64_t>(value); };
+        T origin = std::cmp_greater(min, 0) ? min : (std::cmp_less(max, 0) ? max : T{0});
+        auto up = bits(max) - bits(origin);  // modular arithmetic: exact for any range
+        auto down = bits(origin) - bits(min);
+        bool negative = down != 0 && (up == 0 || source.Draw(1) == 1);
+        auto magnitude = source.Draw(negative ? down : up);
+        return static_cast<T>(negative ? bits(origin) - magnitude : bits(origin) + magnitude);
+    };
+}
+
+inline auto Booleans() {
+    return [](Source& source) { return source.Draw(1) == 1; };
+}
+
+// One of `values`, shrinking toward the first.
+template <typename T>
+auto SampledFrom(std::vector<T> values) {
+    if (values.empty()) {
+        throw std::invalid_argument("SampledFrom: no values");
+    }
+    return [values = std::move(values)](Source& source) -> T {
+        return values[static_cast<std::size_t>(source.Draw(values.size() - 1))];
+    };
+}
+
+// Vectors of up to `max_size` elements, 7 on average. Each element is preceded by a
+// "more" choice, so shrinking can drop an element by deleting its choices.
+template <Generator G>
+auto VectorsOf(G element, std::size_t max_size = 64) {
+    return [element = std::move(element), max_size](Source& source) {
+        std::vector<GeneratedType<G>> values;
+        while (values.size() < max_size && source.Draw(7) != 0) {
+            values.push_back(element(source));
+        }
+        return values;
+    };
+}
+
+// Printable ASCII strings of up to `max_size` characters, shrinking toward "aaa...".
+inline auto Strings(std::size_t max_size = 64) {
+    return [max_size](Source& source) {
+        std::string text;
+        while (text.size() < max_size && source.Draw(7) != 0) {
+            // Rotate so choice 0 is 'a': shrunk strings read better than runs of spaces.
+            text.push_back(static_cast<char>(' ' + (source.Draw(94) + ('a' - ' ')) % 95));
+        }
+        return text;
+    };
+}
+
+template <Generator G, typename F>
+    requires std::invocable<const F&, GeneratedType<G>>
+auto Map(G generator, F transform) {
+    return [generator = std::move(generator), transform = std::move(transform)](Source& source) {
+        return transform(generator(source));
+    };
+}
+
+template <Generator... Gs>
+auto Tuples(Gs... generators) {
+    return [... generators = std::move(generators)](Source& source) {
+        return std::tuple{generators(source)...};  // braced: evaluated left to right
+    };
+}
+
+struct PropertyOptions {
+    // Random inputs tried before the property is considered to hold.
+    std::size_t cases = 1000;
+    // Seed of the run; unset picks a random one. A failure reports the seed, and
+    // setting it reproduces the same counterexample.
+    std::optional<std::uint64_t> seed = std::nullopt;
+    // Threads evaluating cases; 0 uses one per core. Properties usually share state with
+    // the test, so parallel evaluation is opt-in: with more than one thread the property
+    // must be safe to call concurrently.
+    std::size_t threads = 1;
+    // Property evaluations spent shrinking a counterexample.
+    std::size_t max_shrinks = 10000;
+};
+
+namespace detail {
+
+// The failure of `property` for the input generated from `source`, or null if the
+// property holds. A property fails by throwing or, if it returns bool, false. The failure
+// is kept as thrown, so only the case that is reported has its message formatted.
+template <Generator G, typename F>
+auto EvaluateProperty(const G& generate, const F& property, Source& source)
+    -> std::exception_ptr {
+    auto value = generate(source);
+    try {
+        if constexpr (std::same_as<std::invoke_result_t<const F&, decltype(value)&>, bool>) {
+            if (!property(value)) {
+                return std::make_exception_ptr(std::logic_error("property returned false"));
+            }
+        } else {
+            property(value);
+        }
+    } catch (...) {
+        return std::current_exception();
+    }
+    return nullptr;
+}
+
+// The message of a failure returned by EvaluateProperty.
+inline auto FailureMessage(const std::exception_ptr& failure) -> std::string {
+    try {
+        std::rethrow_exception(failure);
+    } catch (const std::exception& e) {
+        return e.what();
+    } catch (...) {
+        return "non-standard exception";
+    }
+}
+
+// Whether choice sequence `a` is simpler than `b`: shorter, or as long and
+// lexicographically smaller. Accepting only simpler candidates bounds shrinking.
+inline auto Simpler(std::span<const std::uint64_t> a, std::span<const std::uint64_t> b) -> bool {
+    if (a.size() != b.size()) {
+        return a.size() < b.size();
+    }
+    return std::ranges::lexicographical_compare(a, b);
+}
+
+// Shrinks the failing choice sequence `choices` (whose failure is `failure`) by deleting
+// chunks, zeroing chunks and lowering single choices until no edit keeps the property
+// failing or `budget` evaluations are spent.
+template <Generator G, typename F>
+void ShrinkChoices(const G& generate, const F& property, std::vector<std::uint64_t>& choices,
+                   std::exception_ptr& failure, std::size_t budget) {
+    auto attempt = [&](const std::vector<std::uint64_t>& candidate) {
+        if (budget == 0) {
+            return false;
+        }
+        --budget;
+        Source source(candidate);
+        auto candidate_failure = EvaluateProperty(generate, property, source);
+        if (!candidate_failure || !Simpler(source.Choices(), choices)) {
+            return false;
+        }
+        choices.assign(source.Choices().begin(), source.Choices().end());
+        failure = std::move(candidate_failure);
+        return true;
+    };
+
+    for (bool improved = true; improved && budget > 0;) {
+        improved = false;
+        for (std::size_t chunk = 8; chunk > 0; chunk /= 2) {
+            for (std::size_t i = 0; i + chunk <= choices.size();) {
+                auto begin = static_cast<std::ptrdiff_t>(i);
+                auto end = static_cast<std::ptrdiff_t>(i + chunk);
+                auto deleted = choices;
+                deleted.erase(deleted.begin() + begin, deleted.begin() + end);
+                if (attempt(deleted)) {
+                    improved = true;  // retry at i, which now holds the next choices
+                    continue;
+                }
+                auto zeroed = choices;
+                if (std::any_of(zeroed.begin() + begin, zeroed.begin() + end,
+                                [](std::uint64_t c) { return c != 0; })) {
+                    std::fill(zeroed.begin() + begin, zeroed.begin() + end, 0);
+                    improved |= attempt(zeroed);
+                }
+                ++i;
+            }
+        }
+        // Binary-search each choice down to the smallest value that still fails.
+        for (std::size_t i = 0; i < choices.size(); ++i) {
+            std::uint64_t low = 0;
+            while (i < choices.size() && low < choices[i]) {
+                auto candidate = choices;
+                candidate[i] = low + (choices[i] - low) / 2;
+                if (attempt(candidate)) {
+                    improved = true;
+                } else if (budget == 0) {
+                    break;
+                } else {
+                    low = candidate[i] + 1;
+                }
+            }
+        }
+    }
+}
+
+// The lowest-numbered failing case in [0, cases), evaluated on `threads` threads; cases
+// whose number exceeds a failure already found are skipped.
+template <Generator G, typename F>
+auto FirstFailingCase(const G& generate, const F& property, std::uint64_t seed,
+                      std::size_t cases, std::size_t threads) -> std::optional<std::size_t> {
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> first{cases};
+    std::mutex error_mutex;
+    std::exception_ptr error;  // thrown by a generator; rethrown on the calling thread
+
+    auto work = [&] {
+        try {
+            for (auto i = next++; i < first.load(); i = next++) {
+                Source source(SplitMix64(seed + (i * SplitMix64::kGamma)).Next());
+                if (EvaluateProperty(generate, property, source)) {
+                    for (auto known = first.load(); i < known;) {
+                        first.compare_exchange_weak(known, i);
+                    }
+                }
+            }
+        } catch (...) {
+            std::scoped_lock lock(error_mutex);
+            error = error ? error : std::current_exception();
+            first = 0;
+        }
+    };
+    if (threads <= 1) {
+        work();
+    } else {
+        std::vector<std::jthread> pool;
+        pool.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            pool.emplace_back(work);
+        }
+    }  // joins
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return first < cases ? std::optional(first.load()) : std::nullopt;
+}
+
+}  // namespace detail
+
+// Checks that `property` holds for `options.cases` inputs from `generate`.
+//
+// `property` takes the generated value and fails by throwing — typically through Expect
+// — or by returning false. Cases may be spread over threads, each with a seed derived from
+// the run's seed and its case number, and the lowest-numbered failing case is kept, so
+// the outcome does not depend on scheduling. That input is then shrunk and reported as
+// an AssertionError showing the minimal counterexample and the seed that reproduces it.
+// ExpectSoft inside the property throws on every thread, so a soft failure fails the case.
+template <Generator G, typename F>
+    requires std::invocable<const F&, GeneratedType<G>&>
+void CheckProperty(const G& generate, const F& property, PropertyOptions options = {},
+                   std::source_location loc = std::source_location::current()) {
+    SoftFailures::Suspend suspend;
+    auto seed = options.seed.value_or(
+        (std::uint64_t{std::random_device{}()} << 32U) | std::random_device{}());
+    auto threads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+    threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(options.cases, 1));
+
+    auto failing = detail::FirstFailingCase(generate, property, seed, options.cases, threads);
+    if (!failing) {
+        return;
+    }
+
+    Source source(SplitMix64(seed + (*failing * SplitMix64::kGamma)).Next());
+    auto failure = detail::EvaluateProperty(generate, property, source);
+    if (!failure) {
+        throw AssertionError("a property that passes when rerun", "a deterministic property",
+                             loc);
+    }
+    std::vector<std::uint64_t> choices(source.Choices().begin(), source.Choices().end());
+    detail::ShrinkChoices(generate, property, choices, failure, options.max_shrinks);
+
+    Source replay(choices);
+    throw AssertionError(
+        Stringify(generate(replay)),
+        std::format("property to hold (seed {:#x}, case {}): {}", seed, *failing,
+                    detail::FailureMessage(failure)),
+        loc);
+}
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_PROPERTY_HPP_
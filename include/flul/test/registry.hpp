@@ -2,60 +2,481 @@
 #define FLUL_TEST_REGISTRY_HPP_
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <format>
 #include <initializer_list>
+#include <memory>
+#include <optional>
 #include <print>
+#include <ranges>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "flul/test/cases.hpp"
+#include "flul/test/filter.hpp"
+#include "flul/test/manifest.hpp"
+#include "flul/test/matrix.hpp"
+#include "flul/test/name_index.hpp"
+#include "flul/test/name_trie.hpp"
+#include "flul/test/string_table.hpp"
 #include "flul/test/suite.hpp"
+#include "flul/test/tags.hpp"
 #include "flul/test/test_entry.hpp"
 
 namespace flul::test {
 
+// Collects the tests of a binary.
+//
+// A registry either owns its entries (built with Add) or views a static table (see
+// static_tests.hpp), which costs nothing at startup. The first call that modifies a
+// table-backed registry — Add, Depend or Filter — copies the table into owned storage.
+//
+// Suites may also be registered lazily with Defer: only a descriptor is stored, and the
+// suite's tests are added when Expand selects it. Run() expands just the suites the
+// active selection can reach.
 class Registry {
    public:
+    // A parameterized test whose cases are the rows of a parameter matrix (matrix.hpp).
+    struct MatrixTest {
+        std::string_view suite_name;
+        std::string_view test_name;
+        std::shared_ptr<const CombinationTable> table;
+    };
+
+    // Where a matrix case comes from: an index into Matrices() and a row of its table.
+    struct MatrixRow {
+        std::size_t matrix;
+        std::uint32_t row;
+    };
+
+    Registry() = default;
+    explicit Registry(std::span<const TestEntry> table) : table_(table) {}
+
+    // The member pointer is stored inside the entry and called through a trampoline
+    // instantiated per suite type, so registration never allocates per test. `tags`
+    // become bits of the entry's tag set (see TagNames).
     template <typename S>
         requires std::derived_from<S, Suite<S>> && std::default_initializable<S>
-    void Add(std::string_view suite_name, std::string_view test_name, void (S::*method)()) {
+    void Add(std::string_view suite_name, std::string_view test_name, void (S::*method)(),
+             std::initializer_list<std::string_view> tags = {}) {
+        Materialize();
         entries_.push_back({
-            suite_name,
-            test_name,
-            [method]() {
-                S instance;
-                instance.SetUp();
-                try {
-                    (instance.*method)();
-                } catch (...) {
-                    instance.TearDown();
-                    throw;
+            .suite_name = suite_name,
+            .test_name = test_name,
+            .callable = TestCallable::With(&InvokeMethod<S>, method),
+            .tags = TagBits(tags),
+        });
+        prerequisites_.emplace_back();
+    }
+
+    // Adds the tests of a manifest table (manifest.hpp). Each entry's comma-separated
+    // tags join the registry's tag set, so --tags and --list --with-tags agree with the
+    // labels CTest reads from the manifest section.
+    void AddManifest(std::span<const ManifestEntry> manifest) {
+        Materialize();
+        entries_.reserve(entries_.size() + manifest.size());
+        for (const auto& entry : manifest) {
+            std::vector<std::string_view> tags;
+            for (auto tag : std::views::split(entry.tags, ',')) {
+                if (!tag.empty()) {
+                    tags.emplace_back(tag.begin(), tag.end());
                 }
-                instance.TearDown();
-            },
+            }
+            auto test = entry.test;
+            test.tags |= TagBits(tags);
+            entries_.push_back(test);
+            prerequisites_.emplace_back();
+        }
+    }
+
+    // The tag of each bit of TestEntry::tags, in order of first use. A registry holds
+    // at most 64 distinct tags.
+    [[nodiscard]] auto TagNames() const -> std::span<const std::string_view> {
+        return tag_names_;
+    }
+
+    // Registers one test per case of `cases`, named "`test_name`/<i>", that calls
+    // `method` with cases[i]. Each case is an ordinary entry, filtered and scheduled on
+    // its own; its parameter is produced only when the case runs. The registry keeps
+    // `cases`, shared with its copies.
+    template <typename S, typename P, CaseSource<P> C>
+        requires std::derived_from<S, Suite<S>> && std::default_initializable<S>
+    void AddParameterized(std::string_view suite_name, std::string_view test_name,
+                          void (S::*method)(P), C cases) {
+        Materialize();
+        auto test = std::make_shared<const ParameterizedTest<S, P, C>>(
+            ParameterizedTest<S, P, C>{.method = method, .cases = std::move(cases)});
+        auto count = static_cast<std::size_t>(std::ranges::size(test->cases));
+        entries_.reserve(entries_.size() + count);
+        for (std::size_t i = 0; i < count; ++i) {
+            entries_.push_back({
+                .suite_name = suite_name,
+                .test_name = Intern(std::format("{}/{}", test_name, i)),
+                .callable = TestCallable::With(
+                    &InvokeCase<S, P, C>,
+                    CaseRef{.test = test.get(), .index = static_cast<std::uint32_t>(i)}),
+            });
+        }
+        prerequisites_.resize(entries_.size());
+        if constexpr (requires { test->cases.Table(); }) {
+            matrices_.push_back({.suite_name = suite_name,
+                                 .test_name = test_name,
+                                 .table = test->cases.Table()});
+            matrix_keys_.push_back({.invoke = &InvokeCase<S, P, C>, .test = test.get()});
+        }
+        cases_.push_back(std::move(test));
+    }
+
+    // The parameterized tests added with MatrixCases, in registration order.
+    [[nodiscard]] auto Matrices() const -> std::span<const MatrixTest> {
+        return matrices_;
+    }
+
+    // The matrix and row that `entry` runs, if it is a case of one of Matrices().
+    [[nodiscard]] auto FindMatrixRow(const TestEntry& entry) const -> std::optional<MatrixRow> {
+        for (std::size_t m = 0; m < matrix_keys_.size(); ++m) {
+            if (entry.callable.invoke == matrix_keys_[m].invoke &&
+                entry.callable.Get<CaseRef>().test == matrix_keys_[m].test) {
+                return MatrixRow{.matrix = m, .row = entry.callable.Get<CaseRef>().index};
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Registers `method` as fuzz target "`suite_name`::`test_name`", run with generated
+    // inputs by --fuzz or by a libFuzzer binary (fuzz.hpp). Each file in `corpus`, if
+    // given, is also registered as a parameterized case "`test_name`/<i>" that replays
+    // it, so saved inputs run as regression tests.
+    template <typename S>
+        requires std::derived_from<S, Suite<S>> && std::default_initializable<S>
+    void AddFuzzTarget(std::string_view suite_name, std::string_view test_name,
+                       void (S::*method)(std::span<const std::byte>),
+                       std::string_view corpus = {}) {
+        FuzzTarget target{.suite_name = suite_name,
+                          .test_name = test_name,
+                          .corpus = corpus.empty() ? corpus : Intern(corpus),
+                          .invoke = &InvokeFuzzTarget<S>};
+        std::memcpy(target.storage.data(), &method, sizeof(method));
+        fuzz_targets_.push_back(target);
+        if (!corpus.empty()) {
+            AddParameterized(suite_name, test_name, method, CorpusCases(corpus));
+        }
+    }
+
+    [[nodiscard]] auto FuzzTargets() const -> std::span<const FuzzTarget> {
+        return fuzz_targets_;
+    }
+
+    // The fuzz target named `full_name` ("Suite::Test"), or null. Does not expand
+    // deferred suites.
+    [[nodiscard]] auto FindFuzzTarget(std::string_view full_name) const -> const FuzzTarget* {
+        auto it = std::ranges::find_if(fuzz_targets_, [&](const FuzzTarget& target) {
+            return HasFullName(target.suite_name, target.test_name, full_name);
         });
+        return it == fuzz_targets_.end() ? nullptr : &*it;
+    }
+
+    // Returns a view of `text` that stays valid as long as this registry or a copy of
+    // it, for names built at runtime. Equal strings share one copy.
+    auto Intern(std::string_view text) -> std::string_view {
+        if (!names_) {
+            names_ = std::make_shared<StringTable>();
+        }
+        return names_->Intern(text);
+    }
+
+    // Defers the registration of suite `suite_name`: `add` is called on expansion and
+    // must only add tests named "`suite_name`::...". Deferred suites are expanded in
+    // Defer order, after the tests already added.
+    void Defer(std::string_view suite_name, void (*add)(Registry&)) {
+        deferred_.push_back({.suite_name = suite_name, .add = add});
+    }
+
+    // Expands every deferred suite whose name satisfies `wanted`; the others stay
+    // deferred and invisible to Tests().
+    template <std::predicate<std::string_view> P>
+    void Expand(P wanted) {
+        // By index: a suite's registration may defer more suites or, through Depend,
+        // expand others.
+        for (std::size_t i = 0; i < deferred_.size(); ++i) {
+            if (deferred_[i].add != nullptr && wanted(deferred_[i].suite_name)) {
+                std::exchange(deferred_[i].add, nullptr)(*this);
+            }
+        }
+    }
+
+    void ExpandAll() {
+        Expand([](std::string_view) { return true; });
+    }
+
+    // Declares that `test` may only start after `prerequisite` has passed; if the
+    // prerequisite fails, `test` is skipped. Both are "Suite::Test" names of registered
+    // tests; a deferred suite named by either is expanded first. Throws
+    // std::invalid_argument for unknown names and for a dependency that would close a
+    // cycle.
+    void Depend(std::string_view test, std::string_view prerequisite) {
+        Materialize();
+        Expand([&](std::string_view suite) {
+            return InGroup(test, suite) || InGroup(prerequisite, suite);
+        });
+        auto t = IndexOf(test);
+        auto p = IndexOf(prerequisite);
+        if (DependsOn(p, t)) {
+            throw std::invalid_argument(
+                std::format("{} cannot depend on {}: {} already depends on {}", test,
+                            prerequisite, prerequisite, test));
+        }
+        if (std::ranges::find(prerequisites_[t], p) == prerequisites_[t].end()) {
+            prerequisites_[t].push_back(p);
+        }
+    }
+
+    // Indices into Tests() of each test's direct prerequisites.
+    [[nodiscard]] auto Prerequisites() const -> std::span<const std::vector<std::uint32_t>> {
+        return prerequisites_;
     }
 
     [[nodiscard]] auto Tests() const -> std::span<const TestEntry> {
-        return entries_;
+        return table_.empty() ? std::span<const TestEntry>(entries_) : table_;
     }
 
+    // Keeps the tests matching `pattern` (see NamePatterns), plus everything they depend
+    // on. Throws std::invalid_argument for a malformed pattern.
     void Filter(std::string_view pattern) {
-        std::erase_if(entries_, [pattern](const TestEntry& e) {
-            return !std::format("{}::{}", e.suite_name, e.test_name).contains(pattern);
-        });
+        const std::array patterns = {pattern};
+        TestFilter filter(patterns, {});
+        Filter(filter);
+    }
+
+    // Keeps the tests `filter` selects, plus everything they depend on, in one pass.
+    void Filter(TestFilter& filter) {
+        Materialize();
+        std::vector<std::uint32_t> selected;
+        for (std::uint32_t i = 0; i < entries_.size(); ++i) {
+            if (filter.Selects(entries_[i])) {
+                selected.push_back(i);
+            }
+        }
+        Retain(std::move(selected));
     }
 
-    void List() const {
-        for (const auto& e : entries_) {
-            std::println("{}::{}", e.suite_name, e.test_name);
+    // Keeps the tests with exactly the given full names, plus everything they depend on.
+    // Returns the names that match no test; the others are selected regardless.
+    auto Select(std::span<const std::string_view> names) -> std::vector<std::string_view> {
+        Materialize();
+        NameIndex index(entries_);
+        std::vector<std::uint32_t> selected;
+        std::vector<std::string_view> unknown;
+        selected.reserve(names.size());
+        for (auto name : names) {
+            if (auto i = index.Find(name)) {
+                selected.push_back(*i);
+            } else {
+                unknown.push_back(name);
+            }
         }
+        Retain(std::move(selected));
+        return unknown;
+    }
+
+    // Keeps the tests in the group `path` ("Storage::Btree" selects every test whose
+    // name continues from that prefix at a "::"), plus everything they depend on.
+    // Returns false, leaving the registry unchanged, when no such group exists.
+    auto SelectPrefix(std::string_view path) -> bool {
+        Materialize();
+        NameTrie trie(entries_);
+        auto node = trie.Find(path);
+        if (!node) {
+            return false;
+        }
+        Retain(trie.Subtree(*node));
+        return true;
+    }
+
+    // Keeps the tests whose tags satisfy `expression`, plus everything they depend on.
+    void FilterTags(const TagExpression& expression) {
+        Materialize();
+        auto bitmap = expression.Evaluate(entries_, tag_names_);
+        std::vector<std::uint32_t> selected;
+        for (std::size_t w = 0; w < bitmap.size(); ++w) {
+            for (auto word = bitmap[w]; word != 0; word &= word - 1) {
+                auto bit = static_cast<std::size_t>(std::countr_zero(word));
+                selected.push_back(static_cast<std::uint32_t>((w * 64) + bit));
+            }
+        }
+        Retain(std::move(selected));
+    }
+
+    // Prints "Suite::Test" per line; with `with_tags`, followed by a tab and the test's
+    // tags separated by commas.
+    void List(bool with_tags = false) const {
+        for (const auto& e : Tests()) {
+            if (!with_tags) {
+                std::println("{}::{}", e.suite_name, e.test_name);
+                continue;
+            }
+            std::string tags;
+            for (auto bits = e.tags; bits != 0; bits &= bits - 1) {
+                tags += tags.empty() ? "" : ",";
+                tags += tag_names_[static_cast<std::size_t>(std::countr_zero(bits))];
+            }
+            std::println("{}::{}\t{}", e.suite_name, e.test_name, tags);
+        }
+    }
+
+    // Lists the tests as a tree of "::"-separated groups with per-group counts.
+    void ListTree() const {
+        NameTrie(Tests()).Print(stdout);
     }
 
    private:
+    template <typename S, typename P, typename C>
+    struct ParameterizedTest {
+        void (S::*method)(P);
+        C cases;
+    };
+
+    // What a parameterized case's callable stores: its ParameterizedTest and case index.
+    struct CaseRef {
+        const void* test;
+        std::uint32_t index;
+    };
+
+    // Identifies the entries of Matrices()[m]: their trampoline and ParameterizedTest.
+    struct MatrixKey {
+        void (*invoke)(const TestCallable& self);
+        const void* test;
+    };
+
+    struct DeferredSuite {
+        std::string_view suite_name;
+        void (*add)(Registry&);  // null once expanded
+    };
+
+    std::span<const TestEntry> table_;  // static table; empty once entries are owned
     std::vector<TestEntry> entries_;
+    std::vector<std::vector<std::uint32_t>> prerequisites_;  // parallel to entries_
+    std::vector<DeferredSuite> deferred_;
+    std::vector<FuzzTarget> fuzz_targets_;
+    std::vector<std::string_view> tag_names_;  // interned; index = bit in TestEntry::tags
+    std::shared_ptr<StringTable> names_;  // shared by copies, whose entries view into it
+    std::vector<std::shared_ptr<const void>> cases_;  // ParameterizedTests, shared likewise
+    std::vector<MatrixTest> matrices_;
+    std::vector<MatrixKey> matrix_keys_;  // parallel to matrices_
+
+    template <typename S>
+    static void InvokeMethod(const TestCallable& self) {
+        RunTestMethod<S>(self.Get<void (S::*)()>());
+    }
+
+    template <typename S>
+    static void InvokeFuzzTarget(const FuzzTarget& self, std::span<const std::byte> input) {
+        void (S::*method)(std::span<const std::byte>) = nullptr;
+        std::memcpy(&method, self.storage.data(), sizeof(method));
+        RunTestMethod<S>(method, input);
+    }
+
+    template <typename S, typename P, typename C>
+    static void InvokeCase(const TestCallable& self) {
+        auto ref = self.Get<CaseRef>();
+        const auto& test = *static_cast<const ParameterizedTest<S, P, C>*>(ref.test);
+        RunTestMethod<S>(test.method, static_cast<P>(test.cases[ref.index]));
+    }
+
+    template <std::ranges::input_range R>
+    auto TagBits(const R& tags) -> std::uint64_t {
+        std::uint64_t bits = 0;
+        for (auto tag : tags) {
+            auto it = std::ranges::find(tag_names_, tag);
+            if (it == tag_names_.end()) {
+                if (tag_names_.size() == 64) {
+                    throw std::invalid_argument(
+                        std::format("cannot add tag '{}': a registry holds at most 64 tags", tag));
+                }
+                it = tag_names_.insert(tag_names_.end(), Intern(tag));
+            }
+            bits |= std::uint64_t{1} << static_cast<std::size_t>(it - tag_names_.begin());
+        }
+        return bits;
+    }
+
+    // Drops every test except `selected` and their transitive prerequisites, keeping
+    // registry order and remapping prerequisite indices.
+    void Retain(std::vector<std::uint32_t> pending) {
+        std::vector<bool> keep(entries_.size(), false);
+        while (!pending.empty()) {
+            auto i = pending.back();
+            pending.pop_back();
+            if (!keep[i]) {
+                keep[i] = true;
+                pending.insert(pending.end(), prerequisites_[i].begin(), prerequisites_[i].end());
+            }
+        }
+
+        std::vector<std::uint32_t> remap(entries_.size());
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < entries_.size(); ++i) {
+            if (keep[i]) {
+                remap[i] = static_cast<std::uint32_t>(kept);
+                if (kept != i) {
+                    entries_[kept] = std::move(entries_[i]);
+                    prerequisites_[kept] = std::move(prerequisites_[i]);
+                }
+                ++kept;
+            }
+        }
+        entries_.resize(kept);
+        prerequisites_.resize(kept);
+        for (auto& prerequisites : prerequisites_) {
+            for (auto& p : prerequisites) {
+                p = remap[p];
+            }
+        }
+    }
+
+    void Materialize() {
+        if (!table_.empty()) {
+            entries_.assign(table_.begin(), table_.end());
+            prerequisites_.resize(entries_.size());
+            table_ = {};
+        }
+    }
+
+    auto IndexOf(std::string_view full_name) const -> std::uint32_t {
+        for (std::uint32_t i = 0; i < entries_.size(); ++i) {
+            if (HasFullName(entries_[i], full_name)) {
+                return i;
+            }
+        }
+        throw std::invalid_argument(std::format("no test named '{}'", full_name));
+    }
+
+    // Whether `from` is `to` or (transitively) requires it.
+    auto DependsOn(std::uint32_t from, std::uint32_t to) const -> bool {
+        std::vector<bool> seen(entries_.size(), false);
+        std::vector<std::uint32_t> pending{from};
+        while (!pending.empty()) {
+            auto i = pending.back();
+            pending.pop_back();
+            if (i == to) {
+                return true;
+            }
+            if (!seen[i]) {
+                seen[i] = true;
+                pending.insert(pending.end(), prerequisites_[i].begin(), prerequisites_[i].end());
+            }
+        }
+        return false;
+    }
 };
 
 // Out-of-line definition of Suite<Derived>::AddTests.
@@ -69,6 +490,15 @@ void Suite<Derived>::AddTests(
     }
 }
 
+template <typename Derived>
+void Suite<Derived>::AddTests(
+    Registry& r, std::string_view suite_name, std::initializer_list<std::string_view> tags,
+    std::initializer_list<std::pair<std::string_view, void (Derived::*)()>> tests) {
+    for (const auto& [name, method] : tests) {
+        r.Add<Derived>(suite_name, name, method, tags);
+    }
+}
+
 }  // namespace flul::test
 
 #endif  // FLUL_TEST_REGISTRY_HPP_
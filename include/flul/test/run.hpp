@@ -1,39 +1,420 @@
 #ifndef FLUL_TEST_RUN_HPP_
 #define FLUL_TEST_RUN_HPP_
 
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <optional>
 #include <print>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "flul/test/bisect.hpp"
+#include "flul/test/filter.hpp"
+#include "flul/test/fuzz.hpp"
+#include "flul/test/name_trie.hpp"
 #include "flul/test/registry.hpp"
 #include "flul/test/runner.hpp"
+#include "flul/test/runner_options.hpp"
+#include "flul/test/tags.hpp"
 
 namespace flul::test {
 
+inline void PrintUsage(std::FILE* stream, std::string_view program) {
+    std::println(stream,
+                 "usage: {} [--list] [--filter <pattern>]... [--exclude <pattern>]...\n"
+                 "       [--exact <Suite::Test>]... [--tests-from <file>] [--prefix <group>]\n"
+                 "       [--tags <expression>] [--list-tree] [--with-tags] [--group-timing]\n"
+                 "       [--no-capture] [--show-output]\n"
+                 "       [--output-limit <bytes>] [--workers <n>|auto]\n"
+                 "       [--max-memory-per-test <bytes>[K|M|G]]\n"
+                 "       [--soak <duration>[ms|s|m|h]] [--soak-output <file>]\n"
+                 "       [--bisect-polluter <Suite::Test>]\n"
+                 "       [--fuzz <Suite::Test>] [--fuzz-runs <n>] [--fuzz-time <duration>]\n"
+                 "       [--fuzz-seed <n>]\n"
+                 "       [--help]",
+                 program);
+}
+
+inline auto ParseSize(std::string_view text) -> std::optional<std::size_t> {
+    std::size_t value = 0;
+    const auto* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc{} || ptr != end) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// Decimal, or hexadecimal after "0x" as the seeds of fuzz runs are printed.
+inline auto ParseSeed(std::string_view text) -> std::optional<std::uint64_t> {
+    auto base = 10;
+    if (text.starts_with("0x") || text.starts_with("0X")) {
+        text.remove_prefix(2);
+        base = 16;
+    }
+    std::uint64_t value = 0;
+    const auto* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value, base);
+    if (ec != std::errc{} || ptr != end || text.empty()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// Byte count with an optional binary suffix: 512, 64K, 256M, 2G.
+inline auto ParseBytes(std::string_view text) -> std::optional<std::size_t> {
+    std::size_t scale = 1;
+    if (!text.empty()) {
+        switch (text.back()) {
+            case 'K':
+                scale = std::size_t{1} << 10U;
+                break;
+            case 'M':
+                scale = std::size_t{1} << 20U;
+                break;
+            case 'G':
+                scale = std::size_t{1} << 30U;
+                break;
+            default:
+                break;
+        }
+    }
+    if (scale != 1) {
+        text.remove_suffix(1);
+    }
+    auto value = ParseSize(text);
+    if (!value || *value > std::numeric_limits<std::size_t>::max() / scale) {
+        return std::nullopt;
+    }
+    return *value * scale;
+}
+
+// Test names for --tests-from, one per line. Blank lines and lines starting with '#' are
+// skipped, and surrounding whitespace is trimmed.
+inline auto ReadTestList(const char* path) -> std::optional<std::vector<std::string>> {
+    std::ifstream file(path);
+    if (!file) {
+        return std::nullopt;
+    }
+    std::vector<std::string> names;
+    for (std::string line; std::getline(file, line);) {
+        auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        auto last = line.find_last_not_of(" \t\r");
+        names.push_back(line.substr(first, last - first + 1));
+    }
+    return names;
+}
+
+// Duration with a unit suffix: 500ms, 30s, 15m, 8h. A bare number means seconds.
+inline auto ParseDuration(std::string_view text) -> std::optional<std::chrono::nanoseconds> {
+    using namespace std::chrono;  // NOLINT(google-build-using-namespace)
+
+    nanoseconds unit = seconds(1);
+    if (text.ends_with("ms")) {
+        unit = milliseconds(1);
+        text.remove_suffix(2);
+    } else if (text.ends_with('s')) {
+        text.remove_suffix(1);
+    } else if (text.ends_with('m')) {
+        unit = minutes(1);
+        text.remove_suffix(1);
+    } else if (text.ends_with('h')) {
+        unit = hours(1);
+        text.remove_suffix(1);
+    }
+    auto value = ParseSize(text);
+    if (!value ||
+        *value > static_cast<std::size_t>(std::numeric_limits<nanoseconds::rep>::max() /
+                                          unit.count())) {
+        return std::nullopt;
+    }
+    return unit * static_cast<nanoseconds::rep>(*value);
+}
+
+// Expands the deferred suites of `registry` that can contain a selected test: one named
+// by `exact` (when given), one inside or containing the group `prefix` (when not empty),
+// and one `filter` may match (when given). Without any selection every suite is expanded.
+inline void ExpandSelected(Registry& registry,
+                           std::optional<std::span<const std::string_view>> exact,
+                           std::string_view prefix, TestFilter* filter) {
+    // Every "::"-delimited prefix of an exact name may be its suite.
+    std::unordered_set<std::string_view> suites;
+    for (auto name : exact.value_or(std::span<const std::string_view>())) {
+        for (auto end = name.find("::"); end != std::string_view::npos;
+             end = name.find("::", end + 2)) {
+            suites.insert(name.substr(0, end));
+        }
+    }
+    registry.Expand([&](std::string_view suite) {
+        return (!exact || suites.contains(suite)) &&
+               (prefix.empty() || InGroup(suite, prefix) || InGroup(prefix, suite)) &&
+               (filter == nullptr || filter->MayMatchSuite(suite));
+    });
+}
+
+// --fuzz: fuzzes the target named `name`, seeded with its corpus and `seed`, or a random
+// seed when unset. The seed is printed before the first input runs, so a run that dies
+// from a signal can still be reproduced with --fuzz-seed.
+inline auto RunFuzzTarget(Registry& registry, std::string_view name, FuzzOptions options,
+                          std::optional<std::uint64_t> seed = std::nullopt) -> int {
+    ExpandSelected(registry, std::span(&name, 1), {}, nullptr);
+    const auto* target = registry.FindFuzzTarget(name);
+    if (target == nullptr) {
+        std::println(stderr, "error: no fuzz target named '{}'", name);
+        return 1;
+    }
+    std::vector<std::vector<std::byte>> corpus;
+    if (!target->corpus.empty()) {
+        CorpusCases cases(target->corpus);
+        for (std::size_t i = 0; i < cases.size(); ++i) {
+            corpus.push_back(cases[i]);
+        }
+    }
+    options.seed =
+        seed.value_or((std::uint64_t{std::random_device{}()} << 32U) | std::random_device{}());
+    std::println("fuzz: {}::{} with seed {:#x}", target->suite_name, target->test_name,
+                 options.seed);
+    std::fflush(stdout);
+    return Fuzz(*target, std::move(corpus), options);
+}
+
 inline auto Run(int argc, char* argv[], Registry& registry) -> int {
+    RunnerOptions options;
+    std::string_view bisect_target;
+    std::string_view fuzz_target;
+    FuzzOptions fuzz;
+    std::optional<std::uint64_t> fuzz_seed;
+    std::vector<std::string_view> includes;
+    std::vector<std::string_view> excludes;
+    std::vector<std::string_view> exact;
+    std::vector<std::string> listed;  // owns the names read by --tests-from
+    std::string_view prefix;
+    std::string_view tags;
+    bool select = false;
+    bool list = false;
+    bool with_tags = false;
+    bool list_tree = false;
+
     for (int i = 1; i < argc; ++i) {
         auto arg = std::string_view(argv[i]);
 
         if (arg == "--list") {
-            registry.List();
-            return 0;
-        }
-        if (arg == "--filter") {
+            list = true;
+        } else if (arg == "--with-tags") {
+            with_tags = true;
+        } else if (arg == "--tags") {
             if (i + 1 >= argc) {
-                std::println(stderr, "error: --filter requires an argument");
+                std::println(stderr, "error: --tags requires an expression");
+                return 1;
+            }
+            tags = argv[++i];
+        } else if (arg == "--list-tree") {
+            list_tree = true;
+        } else if (arg == "--group-timing") {
+            options.group_timing = true;
+        } else if (arg == "--prefix") {
+            if (i + 1 >= argc) {
+                std::println(stderr, "error: --prefix requires a group name");
+                return 1;
+            }
+            prefix = argv[++i];
+        } else if (arg == "--filter" || arg == "--exclude") {
+            if (i + 1 >= argc) {
+                std::println(stderr, "error: {} requires an argument", arg);
+                return 1;
+            }
+            (arg == "--filter" ? includes : excludes).emplace_back(argv[++i]);
+        } else if (arg == "--exact") {
+            if (i + 1 >= argc) {
+                std::println(stderr, "error: --exact requires a test name");
+                return 1;
+            }
+            exact.emplace_back(argv[++i]);
+            select = true;
+        } else if (arg == "--tests-from") {
+            if (i + 1 >= argc) {
+                std::println(stderr, "error: --tests-from requires a file name");
+                return 1;
+            }
+            auto names = ReadTestList(argv[++i]);
+            if (!names) {
+                std::println(stderr, "error: cannot read test list '{}'", argv[i]);
+                return 1;
+            }
+            listed.insert(listed.end(), std::make_move_iterator(names->begin()),
+                          std::make_move_iterator(names->end()));
+            select = true;
+        } else if (arg == "--no-capture") {
+            options.capture_output = false;
+        } else if (arg == "--show-output") {
+            options.show_output = true;
+        } else if (arg == "--output-limit") {
+            auto limit = i + 1 < argc ? ParseSize(argv[++i]) : std::nullopt;
+            if (!limit) {
+                std::println(stderr, "error: --output-limit requires a byte count");
+                return 1;
+            }
+            options.output_limit = *limit;
+        } else if (arg == "--workers" && i + 1 < argc && std::string_view(argv[i + 1]) == "auto") {
+            options.adaptive_workers = true;
+            ++i;
+        } else if (arg == "--workers") {
+            auto workers = i + 1 < argc ? ParseSize(argv[++i]) : std::nullopt;
+            if (!workers) {
+                std::println(stderr, "error: --workers requires a process count");
+                return 1;
+            }
+            options.workers = *workers;
+        } else if (arg == "--max-memory-per-test") {
+            auto limit = i + 1 < argc ? ParseBytes(argv[++i]) : std::nullopt;
+            if (!limit) {
+                std::println(stderr, "error: --max-memory-per-test requires a size");
+                return 1;
+            }
+            options.max_memory_per_test = *limit;
+        } else if (arg == "--soak") {
+            auto duration = i + 1 < argc ? ParseDuration(argv[++i]) : std::nullopt;
+            if (!duration || *duration <= std::chrono::nanoseconds::zero()) {
+                std::println(stderr, "error: --soak requires a duration");
+                return 1;
+            }
+            options.soak = *duration;
+        } else if (arg == "--soak-output") {
+            if (i + 1 >= argc) {
+                std::println(stderr, "error: --soak-output requires a file name");
+                return 1;
+            }
+            options.soak_output = argv[++i];
+        } else if (arg == "--bisect-polluter") {
+            if (i + 1 >= argc) {
+                std::println(stderr, "error: --bisect-polluter requires a test name");
+                return 1;
+            }
+            bisect_target = argv[++i];
+        } else if (arg == "--fuzz") {
+            if (i + 1 >= argc) {
+                std::println(stderr, "error: --fuzz requires a fuzz target name");
+                return 1;
+            }
+            fuzz_target = argv[++i];
+        } else if (arg == "--fuzz-runs") {
+            auto runs = i + 1 < argc ? ParseSize(argv[++i]) : std::nullopt;
+            if (!runs) {
+                std::println(stderr, "error: --fuzz-runs requires a run count");
+                return 1;
+            }
+            fuzz.runs = *runs;
+        } else if (arg == "--fuzz-time") {
+            auto duration = i + 1 < argc ? ParseDuration(argv[++i]) : std::nullopt;
+            if (!duration || *duration <= std::chrono::nanoseconds::zero()) {
+                std::println(stderr, "error: --fuzz-time requires a duration");
+                return 1;
+            }
+            fuzz.time = *duration;
+        } else if (arg == "--fuzz-seed") {
+            fuzz_seed = i + 1 < argc ? ParseSeed(argv[++i]) : std::nullopt;
+            if (!fuzz_seed) {
+                std::println(stderr, "error: --fuzz-seed requires a number");
                 return 1;
             }
-            registry.Filter(argv[++i]);
         } else if (arg == "--help") {
-            std::println("usage: {} [--list] [--filter <pattern>] [--help]", argv[0]);
+            PrintUsage(stdout, argv[0]);
             return 0;
         } else {
             std::println(stderr, "error: unknown option '{}'", arg);
-            std::println(stderr, "usage: {} [--list] [--filter <pattern>] [--help]", argv[0]);
+            PrintUsage(stderr, argv[0]);
             return 1;
         }
     }
 
-    Runner runner(registry);
+    if (!fuzz_target.empty()) {
+        return RunFuzzTarget(registry, fuzz_target, fuzz, fuzz_seed);
+    }
+
+    std::optional<TestFilter> filter;
+    if (!includes.empty() || !excludes.empty()) {
+        try {
+            filter.emplace(includes, excludes);
+        } catch (const std::invalid_argument& e) {
+            std::println(stderr, "error: {}", e.what());
+            return 1;
+        }
+    }
+    std::optional<TagExpression> tag_expression;
+    if (!tags.empty()) {
+        try {
+            tag_expression.emplace(tags);
+        } catch (const std::invalid_argument& e) {
+            std::println(stderr, "error: {}", e.what());
+            return 1;
+        }
+    }
+    std::optional<std::span<const std::string_view>> selected;
+    if (select) {
+        exact.insert(exact.end(), listed.begin(), listed.end());
+        selected = exact;
+    }
+    ExpandSelected(registry, selected, prefix, filter ? &*filter : nullptr);
+
+    if (select) {
+        auto unknown = registry.Select(exact);
+        for (auto name : unknown) {
+            std::println(stderr, "error: no test named '{}'", name);
+        }
+        if (!unknown.empty()) {
+            return 1;
+        }
+    }
+    if (!prefix.empty() && !registry.SelectPrefix(prefix)) {
+        std::println(stderr, "error: no test group named '{}'", prefix);
+        return 1;
+    }
+    if (filter) {
+        registry.Filter(*filter);
+    }
+    if (tag_expression) {
+        registry.FilterTags(*tag_expression);
+    }
+    if (list) {
+        registry.List(with_tags);
+        return 0;
+    }
+    if (list_tree) {
+        registry.ListTree();
+        return 0;
+    }
+
+    auto out_of_process = options.workers > 0 || options.adaptive_workers;
+    if (options.max_memory_per_test > 0 && !out_of_process) {
+        std::println(stderr, "error: --max-memory-per-test requires --workers");
+        return 1;
+    }
+    // Soak samples the process running the tests, so it has to be this one.
+    if (options.soak > std::chrono::nanoseconds::zero() && out_of_process) {
+        std::println(stderr, "error: --soak cannot be combined with --workers");
+        return 1;
+    }
+
+    if (!bisect_target.empty()) {
+        return BisectPolluter(registry.Tests(), bisect_target, options.workers);
+    }
+
+    Runner runner(registry, options);
     return runner.RunAll();
 }
 
@@ -1,39 +1,112 @@
 #ifndef FLUL_TEST_RUNNER_HPP_
 #define FLUL_TEST_RUNNER_HPP_
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <exception>
 #include <format>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <print>
+#include <queue>
 #include <ranges>
 #include <source_location>
 #include <span>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "flul/test/assertion_error.hpp"
+#include "flul/test/dependencies.hpp"
+#include "flul/test/memory_limit.hpp"
+#include "flul/test/name_trie.hpp"
+#include "flul/test/output_capture.hpp"
+#include "flul/test/process_pool.hpp"
 #include "flul/test/registry.hpp"
+#include "flul/test/runner_options.hpp"
+#include "flul/test/soak.hpp"
+#include "flul/test/soft_failures.hpp"
 #include "flul/test/test_result.hpp"
+#include "flul/test/virtual_clock.hpp"
+#include "flul/test/worker_tuner.hpp"
 
 namespace flul::test {
 
 class Runner {
    public:
-    explicit Runner(const Registry& registry)
-        : registry_(registry) {}  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+    explicit Runner(const Registry& registry, RunnerOptions options = {})
+        : registry_(registry),  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+          options_(options) {}
 
     auto RunAll() -> int {
         auto tests = registry_.Tests();
+        capture_.reset();  // opened again by the process that runs the tests
+        if (options_.soak > std::chrono::nanoseconds::zero()) {
+            return Soak(tests);
+        }
         std::vector<TestResult> results;
         results.reserve(tests.size());
 
-        for (const auto& entry : tests) {
-            auto result = RunTest(entry);
+        auto report = [this, &results](TestResult result) {
             PrintResult(result);
             results.push_back(std::move(result));
+        };
+
+        if (options_.workers > 0 || options_.adaptive_workers) {
+            std::optional<WorkerTuner> tuner;
+            if (options_.adaptive_workers) {
+                auto cores = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+                tuner.emplace(options_.workers > 0 ? options_.workers : cores, 1, 4 * cores,
+                              cores);
+            }
+            ProcessPool pool(tests, options_.workers, tuner ? &*tuner : nullptr,
+                             registry_.Prerequisites());
+            pool.Run(
+                [this](const TestEntry& entry) {
+                    auto result = RunTest(entry, options_.max_memory_per_test);
+                    if (result.passed && !options_.show_output) {
+                        result.output.clear();  // never printed; keep it out of the pool
+                    }
+                    return result;
+                },
+                report);
+        } else {
+            OpenCapture();
+            // Run in registry order, except that a test waits for its prerequisites.
+            DependencyTracker graph(tests.size(), registry_.Prerequisites());
+            std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<>> ready;
+            for (auto index : graph.Initial()) {
+                ready.push(index);
+            }
+            while (!ready.empty()) {
+                auto index = ready.top();
+                ready.pop();
+                auto result = RunTest(tests[index]);
+                result.id = index;
+                auto passed = result.passed;
+                report(std::move(result));
+                auto update = graph.Complete(index, passed);
+                for (auto next : update.ready) {
+                    ready.push(next);
+                }
+                for (auto skipped : update.skipped) {
+                    report(SkippedResult(tests, skipped, index));
+                }
+            }
         }
 
         PrintSummary(results);
+        PrintMatrixCoverage(results);
+        if (options_.group_timing) {
+            PrintGroupTiming(results);
+        }
 
         return std::ranges::all_of(results, &TestResult::passed) ? 0 : 1;
     }
@@ -41,8 +114,123 @@ class Runner {
    private:
     // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members): Registry owned by caller (main)
     const Registry& registry_;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+    RunnerOptions options_;
+    // Reused by every test run in this process; workers open their own after the fork.
+    mutable std::optional<OutputCapture> capture_;
+
+    void OpenCapture() const {
+        if (options_.capture_output && !capture_) {
+            capture_.emplace(options_.output_limit, false);
+        }
+    }
+
+    // `memory_limit` is only passed inside worker processes, where a test that hits its
+    // limit cannot take the coordinator down with it.
+    auto RunTest(const TestEntry& entry, std::size_t memory_limit = 0) const -> TestResult {
+        VirtualClock::ResetLastSimulated();
+        std::optional<MemoryLimit> limit;
+        if (memory_limit > 0) {
+            limit.emplace(memory_limit);
+        }
+        OpenCapture();
+        if (capture_) {
+            capture_->Start();
+        }
+        SoftFailures soft;
+        auto result = Execute(entry);
+        if (soft.Count() > 0) {
+            AddSoftFailures(result, soft);
+        }
+        auto exceeded = limit && limit->Exceeded();
+        limit.reset();  // lift the limit before formatting anything
+
+        result.simulated = VirtualClock::LastSimulated();
+        if (memory_limit > 0) {
+            result.peak_memory = MemoryLimit::PeakResident();
+        }
+        if (exceeded) {
+            auto loc = std::source_location::current();
+            result.passed = false;
+            result.error.emplace(std::format("exceeded memory limit (peak process RSS {})",
+                                             FormatBytes(result.peak_memory)),
+                                 std::format("at most {} allocated per test",
+                                             FormatBytes(memory_limit)),
+                                 loc);
+        }
+        if (capture_) {
+            result.output = capture_->Finish();
+        }
+        return result;
+    }
+
+    // Cycles the tests in-process until `options_.soak` has elapsed, bracketing every run
+    // with resource samples. Only the first failure of each test is printed; the summary
+    // lists tests whose memory, descriptors or threads grew steadily.
+    auto Soak(std::span<const TestEntry> tests) const -> int {
+        using namespace std::chrono;  // NOLINT(google-build-using-namespace)
+
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> series(nullptr, &std::fclose);
+        if (!options_.soak_output.empty()) {
+            series.reset(std::fopen(options_.soak_output.c_str(), "w"));
+            if (!series) {
+                std::println(stderr, "error: cannot open '{}' for writing", options_.soak_output);
+                return 1;
+            }
+            std::println(series.get(), "elapsed_ms,iteration,rss_bytes,fds,threads");
+        }
+
+        OpenCapture();  // before the first sample, so its descriptors are not growth
+        SoakMonitor monitor(tests.size());
+        std::vector<bool> failed(tests.size(), false);
+        std::size_t iteration = 0;
+        std::size_t runs = 0;
+        std::size_t failures = 0;
+        auto start = steady_clock::now();
+        auto deadline = start + options_.soak;
+
+        auto order = DependencyTracker(tests.size(), registry_.Prerequisites()).Order();
+        while (!tests.empty() && steady_clock::now() < deadline) {
+            for (auto i : order) {
+                auto before = SampleResources();
+                auto result = RunTest(tests[i]);
+                result.id = i;
+                auto after = SampleResources();
+                monitor.Record(i, iteration, before, after);
+                ++runs;
+                if (!result.passed) {
+                    ++failures;
+                    if (!failed[i]) {
+                        failed[i] = true;
+                        PrintResult(result);
+                    }
+                }
+            }
+            if (series) {
+                auto sample = SampleResources();
+                auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start);
+                std::println(series.get(), "{},{},{},{},{}", elapsed.count(), iteration,
+                             sample.rss, sample.fds, sample.threads);
+            }
+            ++iteration;
+        }
+
+        std::println("");
+        std::println("soak: {} iterations in {}, {} test runs, {} failed", iteration,
+                     FormatDuration(steady_clock::now() - start), runs, failures);
+        auto growth = monitor.Flagged();
+        for (const auto& g : growth) {
+            auto amount = g.metric == 0 ? FormatBytes(static_cast<std::size_t>(g.per_iteration))
+                                        : std::format("{:.2f}", g.per_iteration);
+            std::println("[ GROW ] {}::{} {} +{}/iteration (r\u00b2 {:.2f})",
+                         tests[g.test].suite_name, tests[g.test].test_name,
+                         ResourceSample::MetricName(g.metric), amount, g.r_squared);
+        }
+        std::fflush(stdout);
+
+        return failures == 0 && growth.empty() ? 0 : 1;
+    }
 
-    static auto RunTest(const TestEntry& entry) -> TestResult {
+    static auto Execute(const TestEntry& entry) -> TestResult {
         using namespace std::chrono;  // NOLINT(google-build-using-namespace)
 
         auto start = steady_clock::now();
@@ -55,13 +243,13 @@ class Runner {
                     .passed = true,
                     .duration = duration,
                     .error = std::nullopt};
-        } catch (const AssertionError& e) {
+        } catch (AssertionError& e) {
             auto duration = steady_clock::now() - start;
             return {.suite_name = entry.suite_name,
                     .test_name = entry.test_name,
                     .passed = false,
                     .duration = duration,
-                    .error = e};
+                    .error = std::move(e)};
         } catch (const std::exception& e) {
             auto duration = steady_clock::now() - start;
             auto loc = std::source_location::current();
@@ -82,22 +270,160 @@ class Runner {
         }
     }
 
-    static void PrintResult(const TestResult& result) {
+    // Fails `result` with the failed soft expectations of its test, which come before the
+    // failure that ended the test, if any.
+    static void AddSoftFailures(TestResult& result, SoftFailures& soft) {
+        auto& failures = soft.Failures();
+        result.unstored_failures = soft.Count() - failures.size();
+        if (result.error) {
+            failures.push_back(std::move(*result.error));
+        }
+        result.passed = false;
+        result.error = std::move(failures.front());
+        result.more_failures.assign(std::make_move_iterator(failures.begin() + 1),
+                                    std::make_move_iterator(failures.end()));
+    }
+
+    // Formats the whole block first and writes it with a single call, so a test's
+    // diagnostics and captured output are never split apart.
+    void PrintResult(const TestResult& result) const {
+        if (result.skipped) {
+            std::println("[ SKIP ] {}::{} ({})", result.suite_name, result.test_name,
+                         *result.skipped);
+            std::fflush(stdout);
+            return;
+        }
         const auto* tag = result.passed ? "PASS" : "FAIL";
-        std::println("[ {} ] {}::{} ({})", tag, result.suite_name, result.test_name,
-                     FormatDuration(result.duration));
+        auto timing = FormatDuration(result.duration);
+        if (result.simulated > std::chrono::nanoseconds::zero()) {
+            timing += ", simulated " + FormatDuration(result.simulated);
+        }
+        auto text = std::format("[ {} ] {}::{} ({})\n", tag, result.suite_name,
+                                result.test_name, timing);
 
         if (!result.passed && result.error) {
-            std::println("  {}", result.error->what());
+            text += std::format("  {}\n", result.error->Message());
+            for (const auto& failure : result.more_failures) {
+                text += std::format("  {}\n", failure.Message());
+            }
+            if (result.unstored_failures > 0) {
+                text += std::format("  ... {} more failures not stored\n",
+                                    result.unstored_failures);
+            }
+        }
+        if ((!result.passed || options_.show_output) && !result.output.empty()) {
+            text += "  --- output ---\n";
+            text += result.output;
+            if (!result.output.ends_with('\n')) {
+                text += '\n';
+            }
+            text += "  --------------\n";
         }
+
+        std::print("{}", text);
+        std::fflush(stdout);
     }
 
     static void PrintSummary(std::span<const TestResult> results) {
         auto passed = std::ranges::count_if(results, &TestResult::passed);
-        auto failed = static_cast<std::ptrdiff_t>(results.size()) - passed;
+        auto skipped = std::ranges::count_if(
+            results, [](const TestResult& r) { return r.skipped.has_value(); });
+        auto failed = static_cast<std::ptrdiff_t>(results.size()) - passed - skipped;
+
+        std::println("");
+        if (skipped > 0) {
+            std::println("{} tests, {} passed, {} failed, {} skipped", results.size(), passed,
+                         failed, skipped);
+        } else {
+            std::println("{} tests, {} passed, {} failed", results.size(), passed, failed);
+        }
+    }
+
+    // For each parameter matrix with cases in `results`: how many of its combinations ran,
+    // and how many of its t-way value combinations they covered.
+    void PrintMatrixCoverage(std::span<const TestResult> results) const {
+        auto matrices = registry_.Matrices();
+        if (matrices.empty()) {
+            return;
+        }
+        std::vector<std::vector<std::uint32_t>> rows(matrices.size());
+        for (const auto& result : results) {
+            if (result.skipped) {
+                continue;
+            }
+            if (auto found = registry_.FindMatrixRow(registry_.Tests()[result.id])) {
+                rows[found->matrix].push_back(found->row);
+            }
+        }
+        for (std::size_t m = 0; m < matrices.size(); ++m) {
+            if (rows[m].empty()) {
+                continue;
+            }
+            std::ranges::sort(rows[m]);
+            auto [first, last] = std::ranges::unique(rows[m]);
+            rows[m].erase(first, last);
+            const auto& table = *matrices[m].table;
+            auto coverage = table.Coverage(rows[m]);
+            if (coverage.total == 0) {
+                continue;
+            }
+            // A covering array may stand in for a product too large to count.
+            auto product = table.CountProduct();
+            std::println("{}::{}: {} of {} combinations, {}-way coverage {}/{} ({:.1f}%)",
+                         matrices[m].suite_name, matrices[m].test_name, rows[m].size(),
+                         product ? std::to_string(*product)
+                                 : std::format(">{}", std::numeric_limits<std::size_t>::max()),
+                         coverage.strength, coverage.covered, coverage.total,
+                         100.0 * static_cast<double>(coverage.covered) /
+                             static_cast<double>(coverage.total));
+        }
+    }
+
+    // The slowest test groups by total duration. Results are keyed by test id, so the
+    // trie is built over the registry once and no name is compared or hashed per result.
+    void PrintGroupTiming(std::span<const TestResult> results) const {
+        constexpr std::size_t kLines = 10;
+
+        auto tests = registry_.Tests();
+        NameTrie trie(tests);
+        std::vector<std::chrono::nanoseconds> durations(tests.size());
+        for (const auto& result : results) {
+            durations[result.id] += result.duration;
+        }
+        auto totals = trie.Rollup<std::chrono::nanoseconds>(durations);
+
+        std::vector<std::uint32_t> groups;
+        for (std::uint32_t n = 1; n < trie.Nodes().size(); ++n) {
+            if (!trie.Nodes()[n].children.empty()) {
+                groups.push_back(n);
+            }
+        }
+        auto shown = std::min(groups.size(), kLines);
+        std::ranges::partial_sort(groups, groups.begin() + static_cast<std::ptrdiff_t>(shown),
+                                  [&totals](auto a, auto b) { return totals[a] > totals[b]; });
 
         std::println("");
-        std::println("{} tests, {} passed, {} failed", results.size(), passed, failed);
+        std::println("Slowest groups:");
+        for (std::size_t i = 0; i < shown; ++i) {
+            auto n = groups[i];
+            std::println("  {:>10}  {} ({} tests)", FormatDuration(totals[n]), trie.Path(n),
+                         trie.Nodes()[n].count);
+        }
+    }
+
+    static auto FormatBytes(std::size_t bytes) -> std::string {
+        constexpr double kKiB = 1024.0;
+        auto value = static_cast<double>(bytes);
+        if (value < kKiB) {
+            return std::format("{}B", bytes);
+        }
+        if (value < kKiB * kKiB) {
+            return std::format("{:.1f}KiB", value / kKiB);
+        }
+        if (value < kKiB * kKiB * kKiB) {
+            return std::format("{:.1f}MiB", value / (kKiB * kKiB));
+        }
+        return std::format("{:.1f}GiB", value / (kKiB * kKiB * kKiB));
     }
 
     static auto FormatDuration(std::chrono::nanoseconds ns) -> std::string {
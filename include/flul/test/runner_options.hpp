@@ -0,0 +1,35 @@
+#ifndef FLUL_TEST_RUNNER_OPTIONS_HPP_
+#define FLUL_TEST_RUNNER_OPTIONS_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace flul::test {
+
+struct RunnerOptions {
+    // Redirect stdout/stderr of each test into a per-test buffer.
+    bool capture_output = true;
+    // Replay captured output for passing tests as well, not only for failures.
+    bool show_output = false;
+    // Maximum number of captured bytes kept per test.
+    std::size_t output_limit = std::size_t{64} * 1024;
+    // Number of worker processes sharing one work queue; 0 runs every test in-process.
+    std::size_t workers = 0;
+    // Tune the worker count at runtime, starting from `workers` (or the number of cores
+    // if 0) and staying between 1 and four workers per core.
+    bool adaptive_workers = false;
+    // Additional data memory each test may allocate inside a worker; 0 means unlimited.
+    std::size_t max_memory_per_test = 0;
+    // Cycle the tests in-process for this long and report tests whose resource usage
+    // keeps growing; zero runs each test once.
+    std::chrono::nanoseconds soak{};
+    // CSV file receiving one resource sample per soak iteration; empty disables it.
+    std::string soak_output{};
+    // Add the slowest "::"-separated test groups, with their total time, to the summary.
+    bool group_timing = false;
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_RUNNER_OPTIONS_HPP_
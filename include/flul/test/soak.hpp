@@ -0,0 +1,161 @@
+#ifndef FLUL_TEST_SOAK_HPP_
+#define FLUL_TEST_SOAK_HPP_
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "flul/test/memory_limit.hpp"
+
+namespace flul::test {
+
+// Process-wide resource usage at one point in time.
+struct ResourceSample {
+    std::size_t rss = 0;      // resident set size in bytes
+    std::size_t fds = 0;      // open file descriptors
+    std::size_t threads = 0;  // live threads
+
+    static constexpr std::size_t kMetrics = 3;
+
+    [[nodiscard]] auto Metric(std::size_t i) const -> double {
+        const std::array<std::size_t, kMetrics> values = {rss, fds, threads};
+        return static_cast<double>(values[i]);
+    }
+
+    static auto MetricName(std::size_t i) -> std::string_view {
+        constexpr std::array<std::string_view, kMetrics> kNames = {"rss", "fds", "threads"};
+        return kNames[i];
+    }
+};
+
+// Samples the calling process from /proc; fields stay 0 where /proc is unavailable.
+inline auto SampleResources() -> ResourceSample {
+    ResourceSample sample;
+    sample.rss = ReadProcStatus("VmRSS").value_or(0);
+    sample.threads = ReadProcStatusField("Threads").value_or(0);
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it("/proc/self/fd", ec), end; !ec && it != end;
+         it.increment(ec)) {
+        ++sample.fds;
+    }
+    // The directory iterator itself holds one descriptor while counting.
+    if (sample.fds > 0) {
+        --sample.fds;
+    }
+    return sample;
+}
+
+// Streaming least-squares line fit. Keeps only running sums, so a soak of any length
+// costs a constant amount of memory per series.
+class TrendFit {
+    double n_ = 0;
+    double sum_x_ = 0;
+    double sum_y_ = 0;
+    double sum_xx_ = 0;
+    double sum_xy_ = 0;
+    double sum_yy_ = 0;
+
+   public:
+    void Add(double x, double y) {
+        n_ += 1;
+        sum_x_ += x;
+        sum_y_ += y;
+        sum_xx_ += x * x;
+        sum_xy_ += x * y;
+        sum_yy_ += y * y;
+    }
+
+    [[nodiscard]] auto Count() const -> std::size_t {
+        return static_cast<std::size_t>(n_);
+    }
+
+    // Change of y per unit of x; 0 with fewer than two distinct x values.
+    [[nodiscard]] auto Slope() const -> double {
+        auto sxx = (n_ * sum_xx_) - (sum_x_ * sum_x_);
+        return sxx > 0 ? ((n_ * sum_xy_) - (sum_x_ * sum_y_)) / sxx : 0.0;
+    }
+
+    // Coefficient of determination: 1 for points exactly on a line, near 0 for noise.
+    [[nodiscard]] auto RSquared() const -> double {
+        auto sxx = (n_ * sum_xx_) - (sum_x_ * sum_x_);
+        auto syy = (n_ * sum_yy_) - (sum_y_ * sum_y_);
+        if (sxx <= 0 || syy <= 0) {
+            return 0.0;
+        }
+        auto sxy = (n_ * sum_xy_) - (sum_x_ * sum_y_);
+        return (sxy * sxy) / (sxx * syy);
+    }
+};
+
+// A test whose resource usage kept growing over a soak run.
+struct Growth {
+    std::size_t test;      // index into the test span
+    std::size_t metric;    // ResourceSample metric index
+    double per_iteration;  // fitted growth per iteration
+    double r_squared;
+};
+
+// Attributes resource growth to tests during a soak run.
+//
+// Each run of a test is bracketed by two samples; the difference is added to that
+// test's cumulative series. A leak makes the series a rising line, while allocator
+// caching and noise make it flat or jagged, so a test is flagged when the line fit has
+// a high R² and the fitted growth over the run exceeds a per-metric floor. The first
+// iterations are skipped to let caches and lazily created threads settle.
+class SoakMonitor {
+   public:
+    static constexpr std::size_t kWarmupIterations = 2;
+    static constexpr std::size_t kMinSamples = 8;
+    static constexpr double kMinRSquared = 0.9;
+    // Growth over the whole run below which a trend is ignored: 64 KiB of RSS, or two
+    // descriptors or threads.
+    static constexpr std::array<double, ResourceSample::kMetrics> kMinTotal = {
+        64.0 * 1024, 2.0, 2.0};
+
+    explicit SoakMonitor(std::size_t tests) : fits_(tests), totals_(tests) {}
+
+    void Record(std::size_t test, std::size_t iteration, const ResourceSample& before,
+                const ResourceSample& after) {
+        if (iteration < kWarmupIterations) {
+            return;
+        }
+        auto& total = totals_[test];
+        for (std::size_t m = 0; m < ResourceSample::kMetrics; ++m) {
+            total[m] += after.Metric(m) - before.Metric(m);
+            fits_[test][m].Add(static_cast<double>(iteration), total[m]);
+        }
+    }
+
+    [[nodiscard]] auto Flagged() const -> std::vector<Growth> {
+        std::vector<Growth> flagged;
+        for (std::size_t t = 0; t < fits_.size(); ++t) {
+            for (std::size_t m = 0; m < ResourceSample::kMetrics; ++m) {
+                const auto& fit = fits_[t][m];
+                if (fit.Count() < kMinSamples) {
+                    continue;
+                }
+                auto slope = fit.Slope();
+                auto r2 = fit.RSquared();
+                auto total = slope * static_cast<double>(fit.Count() - 1);
+                if (slope > 0 && r2 >= kMinRSquared && total >= kMinTotal[m]) {
+                    flagged.push_back(
+                        {.test = t, .metric = m, .per_iteration = slope, .r_squared = r2});
+                }
+            }
+        }
+        return flagged;
+    }
+
+   private:
+    using PerMetric = std::array<TrendFit, ResourceSample::kMetrics>;
+
+    std::vector<PerMetric> fits_;
+    std::vector<std::array<double, ResourceSample::kMetrics>> totals_;
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_SOAK_HPP_
@@ -0,0 +1,85 @@
+#ifndef FLUL_TEST_SOFT_FAILURES_HPP_
+#define FLUL_TEST_SOFT_FAILURES_HPP_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "flul/test/assertion_error.hpp"
+
+namespace flul::test {
+
+// Failed soft expectations of the test running on this thread.
+//
+// The Runner installs one around every test; ExpectSoft records into it instead of
+// throwing, so the test keeps running and all of its mismatches are reported together.
+// Only the first kStoreLimit failures are kept — a validation loop over a large data set
+// that fails everywhere costs a counter increment per extra failure, not a vector that
+// grows with the data. Collectors nest: the innermost one on the thread receives the
+// failures until it is destroyed, and a Suspend hides them all.
+class SoftFailures {
+   public:
+    static constexpr std::size_t kStoreLimit = 32;
+
+    // Makes soft expectations on this thread throw until destroyed. Code that turns a
+    // thrown failure into its own verdict — CheckProperty, ExpectCallable — holds one, so
+    // a soft expectation inside it behaves the same on the test thread as on any other.
+    class Suspend {
+       public:
+        Suspend() noexcept : saved_(std::exchange(current_, nullptr)) {}
+        Suspend(const Suspend&) = delete;
+        auto operator=(const Suspend&) -> Suspend& = delete;
+        Suspend(Suspend&&) = delete;
+        auto operator=(Suspend&&) -> Suspend& = delete;
+        ~Suspend() {
+            current_ = saved_;
+        }
+
+       private:
+        SoftFailures* saved_;
+    };
+
+    SoftFailures() noexcept : previous_(current_) {
+        current_ = this;
+    }
+    SoftFailures(const SoftFailures&) = delete;
+    auto operator=(const SoftFailures&) -> SoftFailures& = delete;
+    SoftFailures(SoftFailures&&) = delete;
+    auto operator=(SoftFailures&&) -> SoftFailures& = delete;
+    ~SoftFailures() {
+        current_ = previous_;
+    }
+
+    // The collector of the calling thread, or null when no test is running on it.
+    static auto Current() noexcept -> SoftFailures* {
+        return current_;
+    }
+
+    void Record(AssertionError failure) {
+        ++count_;
+        if (failures_.size() < kStoreLimit) {
+            failures_.push_back(std::move(failure));
+        }
+    }
+
+    // The stored failures, oldest first.
+    [[nodiscard]] auto Failures() -> std::vector<AssertionError>& {
+        return failures_;
+    }
+
+    // Failures recorded, stored or not.
+    [[nodiscard]] auto Count() const -> std::size_t {
+        return count_;
+    }
+
+   private:
+    static inline thread_local SoftFailures* current_ = nullptr;
+
+    SoftFailures* previous_;
+    std::vector<AssertionError> failures_;
+    std::size_t count_ = 0;
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_SOFT_FAILURES_HPP_
@@ -0,0 +1,67 @@
+#ifndef FLUL_TEST_STATIC_TESTS_HPP_
+#define FLUL_TEST_STATIC_TESTS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "flul/test/suite.hpp"
+#include "flul/test/test_entry.hpp"
+
+namespace flul::test {
+
+namespace detail {
+
+template <typename M>
+struct MethodClass;
+
+template <typename S>
+struct MethodClass<void (S::*)()> {
+    using type = S;
+};
+
+template <auto Method>
+void InvokeStatic(const TestCallable& /*self*/) {
+    RunTestMethod<typename MethodClass<decltype(Method)>::type>(Method);
+}
+
+}  // namespace detail
+
+// Compile-time test entry. The member pointer is a template argument, so each entry is
+// a function pointer to its own trampoline and needs no storage or allocation:
+//
+//     inline constexpr std::array kMathTests = {
+//         StaticTest<&MathSuite::TestAdd>("MathSuite", "TestAdd"),
+//         StaticTest<&MathSuite::TestSub>("MathSuite", "TestSub"),
+//     };
+template <auto Method>
+    requires requires { typename detail::MethodClass<decltype(Method)>::type; }
+consteval auto StaticTest(std::string_view suite_name, std::string_view test_name)
+    -> TestEntry {
+    return {.suite_name = suite_name,
+            .test_name = test_name,
+            .callable = {.invoke = &detail::InvokeStatic<Method>}};
+}
+
+// Concatenates test tables at compile time:
+//
+//     inline constexpr auto kAllTests = JoinTables(kMathTests, kStringTests);
+//     flul::test::Registry registry(kAllTests);
+//
+// The result is a constant-initialized array of names and function pointers, so it is
+// placed in read-only data (after relocation) and shared by forked workers.
+template <std::size_t... N>
+consteval auto JoinTables(const std::array<TestEntry, N>&... tables)
+    -> std::array<TestEntry, (N + ... + 0)> {
+    std::array<TestEntry, (N + ... + 0)> joined{};
+    std::size_t next = 0;
+    ((std::ranges::copy(tables, joined.begin() + static_cast<std::ptrdiff_t>(next)),
+      next += N),
+     ...);
+    return joined;
+}
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_STATIC_TESTS_HPP_
@@ -0,0 +1,39 @@
+#ifndef FLUL_TEST_STRING_TABLE_HPP_
+#define FLUL_TEST_STRING_TABLE_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace flul::test {
+
+// Interns strings: each distinct string is stored once.
+//
+// Views returned by Intern() stay valid for the lifetime of the table, since the deque
+// never moves its elements, so interned names can be stored in TestEntry like string
+// literals. Used for names generated at runtime, e.g. parameterized test cases.
+class StringTable {
+   public:
+    auto Intern(std::string_view text) -> std::string_view {
+        if (auto it = views_.find(text); it != views_.end()) {
+            return *it;
+        }
+        const auto& stored = strings_.emplace_back(text);
+        views_.insert(stored);
+        return stored;
+    }
+
+    [[nodiscard]] auto Size() const -> std::size_t {
+        return strings_.size();
+    }
+
+   private:
+    std::deque<std::string> strings_;
+    std::unordered_set<std::string_view> views_;  // view into strings_
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_STRING_TABLE_HPP_
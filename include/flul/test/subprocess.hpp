@@ -0,0 +1,192 @@
+#ifndef FLUL_TEST_SUBPROCESS_HPP_
+#define FLUL_TEST_SUBPROCESS_HPP_
+
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <concepts>
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <system_error>
+
+namespace flul::test {
+
+struct ChildOutcome {
+    enum class Kind {
+        kReturned,  // callable returned normally
+        kThrew,     // callable let an exception escape
+        kExited,    // process called exit()/_exit(); `code` holds the status
+        kSignaled,  // process was killed by a signal; `code` holds the signal number
+        kTimedOut,  // process outlived the timeout and was killed; `code` holds it in ms
+    };
+
+    Kind kind;
+    int code;
+    std::string stderr_text;
+};
+
+// Runs `fn` in a forked child process and reports how the child ended.
+//
+// The child shares nothing with the parent after the fork, so the callable may abort,
+// exit or crash without affecting the caller. Its stderr is collected through a pipe
+// (at most `stderr_limit` bytes are kept); stdout is inherited. Core dumps are disabled
+// in the child so that expected aborts stay cheap. A child still running after `timeout`
+// is killed with SIGKILL. Reading stops once the child has been reaped, so a grandchild
+// that inherited the pipes cannot hold the caller until it exits.
+template <std::invocable F>
+auto RunInChild(F& fn, std::size_t stderr_limit = std::size_t{64} * 1024,
+                std::chrono::milliseconds timeout = std::chrono::seconds(30)) -> ChildOutcome {
+    using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace)
+
+    constexpr char kReturnedMark = 'R';
+    constexpr char kThrewMark = 'T';
+    // How often a child that keeps its pipes open is checked for having exited.
+    constexpr auto kReapInterval = 100ms;
+
+    int err_pipe[2];
+    int status_pipe[2];
+    if (::pipe(err_pipe) != 0) {
+        throw std::system_error(errno, std::generic_category(), "pipe");
+    }
+    if (::pipe(status_pipe) != 0) {
+        ::close(err_pipe[0]);
+        ::close(err_pipe[1]);
+        throw std::system_error(errno, std::generic_category(), "pipe");
+    }
+
+    // Buffered stdio must not be duplicated into the child.
+    std::fflush(stdout);
+    std::fflush(stderr);
+
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        auto error = errno;
+        for (int fd : {err_pipe[0], err_pipe[1], status_pipe[0], status_pipe[1]}) {
+            ::close(fd);
+        }
+        throw std::system_error(error, std::generic_category(), "fork");
+    }
+
+    if (pid == 0) {
+        ::close(err_pipe[0]);
+        ::close(status_pipe[0]);
+        ::dup2(err_pipe[1], STDERR_FILENO);
+        ::close(err_pipe[1]);
+
+        rlimit no_core{.rlim_cur = 0, .rlim_max = 0};
+        ::setrlimit(RLIMIT_CORE, &no_core);
+
+        char mark = kReturnedMark;
+        try {
+            fn();
+        } catch (...) {
+            mark = kThrewMark;
+        }
+        std::fflush(stdout);
+        std::fflush(stderr);
+        [[maybe_unused]] auto written = ::write(status_pipe[1], &mark, 1);
+        ::_exit(mark == kReturnedMark ? 0 : 1);
+    }
+
+    ::close(err_pipe[1]);
+    ::close(status_pipe[1]);
+
+    ChildOutcome outcome{.kind = ChildOutcome::Kind::kExited, .code = 0, .stderr_text = {}};
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::array<pollfd, 2> fds{{
+        {.fd = err_pipe[0], .events = POLLIN, .revents = 0},
+        {.fd = status_pipe[0], .events = POLLIN, .revents = 0},
+    }};
+    auto close_pipe = [](pollfd& entry) {
+        ::close(entry.fd);
+        entry.fd = -1;  // poll() skips negative descriptors
+    };
+    char chunk[4096];
+    char mark = 0;
+    int status = 0;
+    bool reaped = false;
+    bool expired = false;
+    for (;;) {
+        auto open = fds[0].fd >= 0 || fds[1].fd >= 0;
+        if (!reaped) {
+            auto waited = ::waitpid(pid, &status, WNOHANG);
+            if (waited < 0 && errno != EINTR) {
+                throw std::system_error(errno, std::generic_category(), "waitpid");
+            }
+            reaped = waited == pid;
+        }
+        if (reaped && !open) {
+            break;
+        }
+        auto left = std::chrono::ceil<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (left <= 0ms) {
+            expired = !reaped;
+            break;
+        }
+        // Once the child is gone, only what is already buffered is read.
+        auto wait = reaped ? 0ms : std::min(left, open ? kReapInterval : 1ms);
+        auto ready = ::poll(fds.data(), fds.size(), static_cast<int>(wait.count()));
+        if (ready < 0 && errno != EINTR) {
+            throw std::system_error(errno, std::generic_category(), "poll");
+        }
+        if (ready == 0 && reaped) {
+            break;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        if (fds[0].revents != 0) {
+            auto n = ::read(fds[0].fd, chunk, sizeof(chunk));
+            if (n > 0) {
+                auto room = stderr_limit - std::min(stderr_limit, outcome.stderr_text.size());
+                outcome.stderr_text.append(chunk, std::min(room, static_cast<std::size_t>(n)));
+            } else if (n == 0 || errno != EINTR) {
+                close_pipe(fds[0]);
+            }
+        }
+        if (fds[1].revents != 0) {
+            auto n = ::read(fds[1].fd, &mark, 1);
+            if (n == 0 || (n < 0 && errno != EINTR)) {
+                close_pipe(fds[1]);
+            }
+        }
+    }
+    for (auto& entry : fds) {
+        if (entry.fd >= 0) {
+            close_pipe(entry);
+        }
+    }
+
+    if (expired) {
+        ::kill(pid, SIGKILL);
+        while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+        outcome.kind = ChildOutcome::Kind::kTimedOut;
+        outcome.code = static_cast<int>(timeout.count());
+    } else if (mark == kReturnedMark) {
+        outcome.kind = ChildOutcome::Kind::kReturned;
+    } else if (mark == kThrewMark) {
+        outcome.kind = ChildOutcome::Kind::kThrew;
+    } else if (WIFSIGNALED(status)) {
+        outcome.kind = ChildOutcome::Kind::kSignaled;
+        outcome.code = WTERMSIG(status);
+    } else {
+        outcome.kind = ChildOutcome::Kind::kExited;
+        outcome.code = WEXITSTATUS(status);
+    }
+    return outcome;
+}
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_SUBPROCESS_HPP_
@@ -1,10 +1,15 @@
 #ifndef FLUL_TEST_SUITE_HPP_
 #define FLUL_TEST_SUITE_HPP_
 
+#include <concepts>
 #include <initializer_list>
+#include <mutex>
+#include <optional>
 #include <string_view>
 #include <utility>
 
+#include "flul/test/virtual_clock.hpp"
+
 namespace flul::test {
 
 class Registry;  // forward declaration — full definition in registry.hpp
@@ -27,10 +32,47 @@ class Suite {
         Registry& r, std::string_view suite_name,
         std::initializer_list<std::pair<std::string_view, void (Derived::*)()>> tests);
 
+    // Same, attaching `tags` to every test of `tests`.
+    static void AddTests(
+        Registry& r, std::string_view suite_name, std::initializer_list<std::string_view> tags,
+        std::initializer_list<std::pair<std::string_view, void (Derived::*)()>> tests);
+
+    // Virtual timeline of this test, created and installed as VirtualClock::now() on the
+    // first call, from any thread, and uninstalled with the instance. Tests that never
+    // call it pay nothing for it; until then now() reads the epoch, as a fresh clock would.
+    auto Clock() -> VirtualClock& {
+        std::call_once(clock_once_, [this] {
+            clock_.emplace();
+            clock_scope_.emplace(*clock_);
+        });
+        return *clock_;
+    }
+
    protected:
     Suite() = default;
+
+   private:
+    std::once_flag clock_once_;
+    std::optional<VirtualClock> clock_;
+    std::optional<VirtualClock::Scope> clock_scope_;  // destroyed first
 };
 
+// Runs one test method with the full lifecycle: a fresh instance, SetUp, the method
+// called with `args`, and TearDown even when the method throws.
+template <typename S, typename... Params, typename... Args>
+    requires std::derived_from<S, Suite<S>> && std::default_initializable<S>
+void RunTestMethod(void (S::*method)(Params...), Args&&... args) {
+    S instance;
+    instance.SetUp();
+    try {
+        (instance.*method)(std::forward<Args>(args)...);
+    } catch (...) {
+        instance.TearDown();
+        throw;
+    }
+    instance.TearDown();
+}
+
 }  // namespace flul::test
 
 #endif  // FLUL_TEST_SUITE_HPP_
@@ -0,0 +1,180 @@
+#ifndef FLUL_TEST_TAGS_HPP_
+#define FLUL_TEST_TAGS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "flul/test/test_entry.hpp"
+
+namespace flul::test {
+
+// A boolean expression over test tags, as given to --tags:
+//
+//     slow and not (io or nightly)
+//     smoke | !flaky
+//
+// `and`/`&` binds tighter than `or`/`|`; `not`/`!` applies to the next operand. Tag
+// names are made of letters, digits, '_', '-' and '.'.
+//
+// The expression is compiled to postfix and evaluated column-wise. Each tag it names
+// becomes a bitmap with one bit per test, built in one pass over the registry, and each
+// operator combines whole bitmaps 64 tests at a time.
+class TagExpression {
+   public:
+    // Tag names are views into `text`, which must outlive the expression. Throws
+    // std::invalid_argument for a malformed expression.
+    explicit TagExpression(std::string_view text) : text_(text) {
+        Parser parser{.self = *this, .rest = text};
+        parser.Or();
+        parser.SkipSpace();
+        if (!parser.rest.empty()) {
+            parser.Fail("unexpected '" + std::string(parser.rest.substr(0, 1)) + "'");
+        }
+    }
+
+    // Bitmap of the tests satisfying the expression: bit i % 64 of word i / 64 is set
+    // when tests[i] does. `tag_names[b]` is the tag stored in bit b of TestEntry::tags;
+    // tags the registry does not know match no test.
+    [[nodiscard]] auto Evaluate(std::span<const TestEntry> tests,
+                                std::span<const std::string_view> tag_names) const
+        -> std::vector<std::uint64_t> {
+        auto words = (tests.size() + 63) / 64;
+        std::vector<std::vector<std::uint64_t>> stack;
+        for (const auto& op : program_) {
+            switch (op.kind) {
+                case Op::kTag:
+                    stack.push_back(Column(tests, tag_names, op.tag, words));
+                    break;
+                case Op::kNot:
+                    for (auto& word : stack.back()) {
+                        word = ~word;
+                    }
+                    if (auto tail = tests.size() % 64; tail != 0) {
+                        stack.back().back() &= (std::uint64_t{1} << tail) - 1;
+                    }
+                    break;
+                case Op::kAnd:
+                case Op::kOr: {
+                    auto right = std::move(stack.back());
+                    stack.pop_back();
+                    auto& left = stack.back();
+                    for (std::size_t w = 0; w < words; ++w) {
+                        left[w] = op.kind == Op::kAnd ? left[w] & right[w] : left[w] | right[w];
+                    }
+                    break;
+                }
+            }
+        }
+        return std::move(stack.back());
+    }
+
+   private:
+    struct Op {
+        enum Kind : std::uint8_t { kTag, kNot, kAnd, kOr } kind;
+        std::string_view tag{};
+    };
+
+    // Recursive descent over `rest`, appending postfix to self.program_.
+    struct Parser {
+        TagExpression& self;
+        std::string_view rest;
+
+        void Or() {
+            And();
+            while (Accept("or") || Accept("|")) {
+                And();
+                self.program_.push_back({.kind = Op::kOr});
+            }
+        }
+
+        void And() {
+            Not();
+            while (Accept("and") || Accept("&")) {
+                Not();
+                self.program_.push_back({.kind = Op::kAnd});
+            }
+        }
+
+        void Not() {
+            if (Accept("not") || Accept("!")) {
+                Not();
+                self.program_.push_back({.kind = Op::kNot});
+            } else if (Accept("(")) {
+                Or();
+                if (!Accept(")")) {
+                    Fail("missing ')'");
+                }
+            } else {
+                auto tag = Word();
+                if (tag.empty() || tag == "and" || tag == "or" || tag == "not") {
+                    Fail(rest.empty() ? "expected a tag at end" : "expected a tag");
+                }
+                rest.remove_prefix(tag.size());
+                self.program_.push_back({.kind = Op::kTag, .tag = tag});
+            }
+        }
+
+        // Consumes `token` if it comes next; a keyword must not run into a tag name.
+        auto Accept(std::string_view token) -> bool {
+            SkipSpace();
+            if (!rest.starts_with(token) ||
+                (IsTagChar(token.front()) && Word().size() != token.size())) {
+                return false;
+            }
+            rest.remove_prefix(token.size());
+            return true;
+        }
+
+        [[nodiscard]] auto Word() const -> std::string_view {
+            auto end = std::ranges::find_if_not(rest, IsTagChar);
+            return rest.substr(0, static_cast<std::size_t>(end - rest.begin()));
+        }
+
+        void SkipSpace() {
+            rest.remove_prefix(std::min(rest.find_first_not_of(" \t"), rest.size()));
+        }
+
+        [[noreturn]] void Fail(const std::string& what) const {
+            throw std::invalid_argument(std::format("invalid tag expression '{}': {} at {}",
+                                                    self.text_, what,
+                                                    self.text_.size() - rest.size()));
+        }
+
+        static auto IsTagChar(char c) -> bool {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                   c == '_' || c == '-' || c == '.';
+        }
+    };
+
+    std::string_view text_;
+    std::vector<Op> program_;
+
+    static auto Column(std::span<const TestEntry> tests,
+                       std::span<const std::string_view> tag_names, std::string_view tag,
+                       std::size_t words) -> std::vector<std::uint64_t> {
+        std::vector<std::uint64_t> column(words, 0);
+        auto bit = std::ranges::find(tag_names, tag);
+        if (bit == tag_names.end()) {
+            return column;
+        }
+        auto mask = std::uint64_t{1} << static_cast<std::size_t>(bit - tag_names.begin());
+        for (std::size_t i = 0; i < tests.size(); ++i) {
+            if ((tests[i].tags & mask) != 0) {
+                column[i / 64] |= std::uint64_t{1} << (i % 64);
+            }
+        }
+        return column;
+    }
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_TAGS_HPP_
@@ -1,15 +1,68 @@
 #ifndef FLUL_TEST_TEST_ENTRY_HPP_
 #define FLUL_TEST_TEST_ENTRY_HPP_
 
-#include <functional>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
 #include <string_view>
+#include <type_traits>
 
 namespace flul::test {
 
+// Non-owning, non-allocating reference to a test body: a trampoline function pointer
+// plus a few bytes of inline storage the trampoline may read (Registry::Add keeps the
+// member function pointer there). Trivially copyable, so copying an entry never touches
+// the heap. Only a callable that sets `invoke` alone, as StaticTest does, can be built
+// in a constant expression; With() fills the storage with memcpy and runs at runtime.
+struct TestCallable {
+    // Large enough for a pointer to member function on every mainstream ABI.
+    static constexpr std::size_t kStorageSize = 2 * sizeof(void*);
+
+    void (*invoke)(const TestCallable& self);
+    alignas(void*) std::array<std::byte, kStorageSize> storage{};
+
+    void operator()() const {
+        invoke(*this);
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T> && (sizeof(T) <= kStorageSize)
+    static auto With(void (*invoke)(const TestCallable&), T value) -> TestCallable {
+        TestCallable callable{.invoke = invoke};
+        std::memcpy(callable.storage.data(), &value, sizeof(T));
+        return callable;
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T> && (sizeof(T) <= kStorageSize)
+    [[nodiscard]] auto Get() const -> T {
+        T value;
+        std::memcpy(&value, storage.data(), sizeof(T));
+        return value;
+    }
+};
+
+// A suite method registered as a fuzz target (Registry::AddFuzzTarget): called with one
+// input per run, through a trampoline and inline storage like TestCallable.
+struct FuzzTarget {
+    std::string_view suite_name;
+    std::string_view test_name;
+    std::string_view corpus;  // directory of saved inputs; empty if none
+    void (*invoke)(const FuzzTarget& self, std::span<const std::byte> input);
+    alignas(void*) std::array<std::byte, TestCallable::kStorageSize> storage{};
+
+    void operator()(std::span<const std::byte> input) const {
+        invoke(*this, input);
+    }
+};
+
 struct TestEntry {
     std::string_view suite_name;
     std::string_view test_name;
-    std::function<void()> callable;
+    TestCallable callable;
+    std::uint64_t tags = 0;  // bit b set: tagged with Registry::TagNames()[b]
 };
 
 }  // namespace flul::test
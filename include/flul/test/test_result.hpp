@@ -2,8 +2,12 @@
 #define FLUL_TEST_TEST_RESULT_HPP_
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include "flul/test/assertion_error.hpp"
 
@@ -12,9 +16,18 @@ namespace flul::test {
 struct TestResult {
     std::string_view suite_name;
     std::string_view test_name;
+    std::uint32_t id{};  // index of the test in Registry::Tests(); keys per-test data
     bool passed;
     std::chrono::nanoseconds duration;
-    std::optional<AssertionError> error;
+    std::optional<AssertionError> error;  // the first failure
+    // Failures after `error`, in order: failed soft expectations, then the failure that
+    // ended the test, if any.
+    std::vector<AssertionError> more_failures{};
+    std::size_t unstored_failures{};  // failures counted but not kept, past the store limit
+    std::string output{};  // captured stdout/stderr, empty when capture is disabled
+    std::chrono::nanoseconds simulated{};  // time the test's VirtualClock advanced
+    std::size_t peak_memory{};  // peak process RSS, only measured under a memory limit
+    std::optional<std::string> skipped{};  // why the test did not run; passed is false
 };
 
 }  // namespace flul::test
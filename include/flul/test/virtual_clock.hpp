@@ -0,0 +1,180 @@
+#ifndef FLUL_TEST_VIRTUAL_CLOCK_HPP_
+#define FLUL_TEST_VIRTUAL_CLOCK_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <set>
+
+namespace flul::test {
+
+// Manually driven clock for time-dependent tests.
+//
+// Code under test that is templated on a Clock (or takes a clock object) uses
+// VirtualClock in place of steady_clock/system_clock. Time only moves when a test calls
+// Advance(), or — with auto-advance on — when every participant thread is blocked in
+// SleepFor/SleepUntil, in which case the clock jumps straight to the earliest deadline.
+// The owning test thread counts as one participant; other threads join with Participant.
+//
+// A Suite instance creates its VirtualClock on the first Suite::Clock() call and installs
+// it as the current clock for the rest of its test, so the static now() gives each test
+// that uses virtual time an isolated timeline.
+class VirtualClock {
+   public:
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<VirtualClock>;
+    static constexpr bool is_steady = true;  // NOLINT(readability-identifier-naming)
+
+    // Calendar time that corresponds to the virtual epoch (2000-01-01T00:00:00Z).
+    static constexpr std::chrono::sys_seconds kSystemEpoch{std::chrono::seconds{946'684'800}};
+
+    VirtualClock() = default;
+    VirtualClock(const VirtualClock&) = delete;
+    auto operator=(const VirtualClock&) -> VirtualClock& = delete;
+    VirtualClock(VirtualClock&&) = delete;
+    auto operator=(VirtualClock&&) -> VirtualClock& = delete;
+    ~VirtualClock() = default;
+
+    // Clock requirement: the time of the clock installed for the running test, or the
+    // epoch if no test is running.
+    static auto now() noexcept -> time_point {  // NOLINT(readability-identifier-naming)
+        const auto* clock = current_.load(std::memory_order_acquire);
+        return clock != nullptr ? clock->Now() : time_point{};
+    }
+
+    static auto ToSys(time_point tp) -> std::chrono::sys_time<duration> {
+        return kSystemEpoch + tp.time_since_epoch();
+    }
+
+    [[nodiscard]] auto Now() const -> time_point {
+        std::scoped_lock lock(mutex_);
+        return now_;
+    }
+
+    // Simulated time that passed since construction.
+    [[nodiscard]] auto Elapsed() const -> duration {
+        return Now().time_since_epoch();
+    }
+
+    void Advance(duration d) {
+        {
+            std::scoped_lock lock(mutex_);
+            now_ += d;
+        }
+        cv_.notify_all();
+    }
+
+    void SetAutoAdvance(bool enabled) {
+        {
+            std::scoped_lock lock(mutex_);
+            auto_advance_ = enabled;
+        }
+        cv_.notify_all();
+    }
+
+    void SleepFor(duration d) {
+        SleepUntil(Now() + d);
+    }
+
+    void SleepUntil(time_point deadline) {
+        std::unique_lock lock(mutex_);
+        if (now_ >= deadline) {
+            return;
+        }
+        auto pending = deadlines_.insert(deadline);
+        ++blocked_;
+        while (now_ < deadline) {
+            if (TryAutoAdvance()) {
+                cv_.notify_all();
+                continue;
+            }
+            cv_.wait(lock);
+        }
+        --blocked_;
+        deadlines_.erase(pending);
+    }
+
+    // Registers the calling thread as a participant for auto-advance.
+    class Participant {
+        VirtualClock& clock_;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+
+       public:
+        explicit Participant(VirtualClock& clock) : clock_(clock) {
+            std::scoped_lock lock(clock_.mutex_);
+            ++clock_.participants_;
+        }
+        Participant(const Participant&) = delete;
+        auto operator=(const Participant&) -> Participant& = delete;
+        Participant(Participant&&) = delete;
+        auto operator=(Participant&&) -> Participant& = delete;
+        ~Participant() {
+            {
+                std::scoped_lock lock(clock_.mutex_);
+                --clock_.participants_;
+            }
+            clock_.cv_.notify_all();
+        }
+    };
+
+    // Installs `clock` as the clock read by now() until destruction. On exit the
+    // simulated time of the timeline is published for LastSimulated().
+    class Scope {
+        VirtualClock& clock_;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+        VirtualClock* previous_;
+
+       public:
+        explicit Scope(VirtualClock& clock)
+            : clock_(clock), previous_(current_.exchange(&clock, std::memory_order_acq_rel)) {}
+        Scope(const Scope&) = delete;
+        auto operator=(const Scope&) -> Scope& = delete;
+        Scope(Scope&&) = delete;
+        auto operator=(Scope&&) -> Scope& = delete;
+        ~Scope() {
+            last_simulated_.store(clock_.Elapsed().count(), std::memory_order_relaxed);
+            current_.store(previous_, std::memory_order_release);
+        }
+    };
+
+    // Simulated time of the most recently finished Scope; the Runner reads this after
+    // each test to report real versus simulated time.
+    static auto LastSimulated() -> duration {
+        return duration{last_simulated_.load(std::memory_order_relaxed)};
+    }
+
+    static void ResetLastSimulated() {
+        last_simulated_.store(0, std::memory_order_relaxed);
+    }
+
+   private:
+    // NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+    static inline std::atomic<VirtualClock*> current_{nullptr};
+    static inline std::atomic<rep> last_simulated_{0};
+    // NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    time_point now_{};
+    std::multiset<time_point> deadlines_;
+    std::size_t participants_ = 1;  // the owning test thread
+    std::size_t blocked_ = 0;
+    bool auto_advance_ = true;
+
+    // Caller holds mutex_. Jumps to the earliest pending deadline when every
+    // participant is asleep.
+    auto TryAutoAdvance() -> bool {
+        if (!auto_advance_ || blocked_ < participants_ || deadlines_.empty() ||
+            *deadlines_.begin() <= now_) {
+            return false;  // someone is already due and about to wake up
+        }
+        now_ = *deadlines_.begin();
+        return true;
+    }
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_VIRTUAL_CLOCK_HPP_
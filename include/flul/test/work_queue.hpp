@@ -0,0 +1,180 @@
+#ifndef FLUL_TEST_WORK_QUEUE_HPP_
+#define FLUL_TEST_WORK_QUEUE_HPP_
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <system_error>
+
+namespace flul::test {
+
+// Array of T in an anonymous MAP_SHARED mapping. Created before fork(), it is visible to
+// the creating process and all of its children at the same address. Only types whose
+// atomics are address-free (lock-free) may be placed here.
+template <typename T>
+class SharedArray {
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+
+   public:
+    explicit SharedArray(std::size_t size) : size_(size) {
+        if (size_ == 0) {
+            return;
+        }
+        void* memory = ::mmap(nullptr, Bytes(), PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        data_ = static_cast<T*>(memory);
+        // Default-initialisation: trivially constructible payloads leave the zero pages
+        // untouched, so large arrays cost nothing until a slot is actually written.
+        std::uninitialized_default_construct_n(data_, size_);
+    }
+
+    SharedArray(const SharedArray&) = delete;
+    auto operator=(const SharedArray&) -> SharedArray& = delete;
+    SharedArray(SharedArray&&) = delete;
+    auto operator=(SharedArray&&) -> SharedArray& = delete;
+
+    ~SharedArray() {
+        if (data_ != nullptr) {
+            std::destroy_n(data_, size_);
+            ::munmap(data_, Bytes());
+        }
+    }
+
+    [[nodiscard]] auto operator[](std::size_t i) const -> T& {
+        return data_[i];
+    }
+
+    [[nodiscard]] auto Size() const -> std::size_t {
+        return size_;
+    }
+
+   private:
+    [[nodiscard]] auto Bytes() const -> std::size_t {
+        return size_ * sizeof(T);
+    }
+};
+
+// Bounded single-producer / multi-consumer queue of test indices in shared memory.
+//
+// The coordinator is the only producer. Workers claim items by advancing `head` with a
+// CAS; they copy the claimed items out *before* the CAS, which is safe because the
+// producer never writes a position in [head, head + capacity). Every test is in the
+// queue at most once at a time, so a capacity equal to the number of tests never
+// overflows.
+class WorkQueue {
+    struct Header {
+        std::atomic<std::uint64_t> head;
+        std::atomic<std::uint64_t> tail;
+        std::atomic<bool> closed;
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+    SharedArray<Header> header_{1};
+    SharedArray<std::atomic<std::uint32_t>> items_;
+
+   public:
+    explicit WorkQueue(std::size_t capacity) : items_(std::max<std::size_t>(capacity, 1)) {}
+
+    // Producer only. Returns false if the queue is full.
+    auto Push(std::uint32_t item) -> bool {
+        auto& h = header_[0];
+        auto tail = h.tail.load(std::memory_order_relaxed);
+        if (tail - h.head.load(std::memory_order_acquire) >= items_.Size()) {
+            return false;
+        }
+        items_[tail % items_.Size()].store(item, std::memory_order_relaxed);
+        h.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Claims up to `out.size()` consecutive items. Returns the number claimed (0 if the
+    // queue is currently empty).
+    auto Claim(std::span<std::uint32_t> out) -> std::size_t {
+        auto& h = header_[0];
+        auto head = h.head.load(std::memory_order_acquire);
+        for (;;) {
+            auto tail = h.tail.load(std::memory_order_acquire);
+            if (head >= tail) {
+                return 0;
+            }
+            auto count = std::min<std::uint64_t>(out.size(), tail - head);
+            for (std::uint64_t i = 0; i < count; ++i) {
+                out[i] = items_[(head + i) % items_.Size()].load(std::memory_order_relaxed);
+            }
+            if (h.head.compare_exchange_weak(head, head + count, std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+                return count;
+            }
+        }
+    }
+
+    [[nodiscard]] auto Size() const -> std::size_t {
+        const auto& h = header_[0];
+        auto tail = h.tail.load(std::memory_order_acquire);
+        auto head = h.head.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    // Closed means the producer will not push again unless it re-opens the queue;
+    // workers exit once the queue is closed and empty.
+    void SetClosed(bool closed) {
+        header_[0].closed.store(closed, std::memory_order_release);
+    }
+
+    [[nodiscard]] auto Closed() const -> bool {
+        return header_[0].closed.load(std::memory_order_acquire);
+    }
+};
+
+// Chooses how many queued tests a worker claims at once.
+//
+// Claiming, timing and notifying cost a few microseconds per work item, which dominates
+// tests that run in under a microsecond. The sizer keeps an exponentially weighted
+// average of the worker's recent test durations and claims enough tests to fill about
+// kTarget of work, starting from single tests until it has a measurement. To keep the
+// tail of a run balanced it never takes more than half of a fair share of what is left.
+class BatchSizer {
+    double average_ns_ = 0;
+    bool measured_ = false;
+
+   public:
+    static constexpr std::size_t kMaxBatch = 64;
+    static constexpr std::chrono::nanoseconds kTarget = std::chrono::microseconds(500);
+    static constexpr double kWeight = 0.25;
+
+    void Observe(std::chrono::nanoseconds duration) {
+        auto ns = static_cast<double>(duration.count());
+        average_ns_ = measured_ ? average_ns_ + (kWeight * (ns - average_ns_)) : ns;
+        measured_ = true;
+    }
+
+    [[nodiscard]] auto Next(std::size_t queued, std::size_t workers) const -> std::size_t {
+        if (!measured_) {
+            return 1;
+        }
+        auto target = static_cast<double>(kTarget.count());
+        auto by_time = average_ns_ * kMaxBatch <= target
+                           ? kMaxBatch
+                           : static_cast<std::size_t>(target / average_ns_);
+        auto fair = queued / (2 * std::max<std::size_t>(workers, 1));
+        return std::clamp<std::size_t>(std::min(by_time, fair), 1, kMaxBatch);
+    }
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_WORK_QUEUE_HPP_
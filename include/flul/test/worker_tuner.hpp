@@ -0,0 +1,158 @@
+#ifndef FLUL_TEST_WORKER_TUNER_HPP_
+#define FLUL_TEST_WORKER_TUNER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <string>
+
+namespace flul::test {
+
+// Busy and total jiffies of all CPUs, from the first line of /proc/stat.
+struct CpuTimes {
+    std::uint64_t busy = 0;
+    std::uint64_t total = 0;
+};
+
+inline auto ReadCpuTimes() -> std::optional<CpuTimes> {
+    std::ifstream stat("/proc/stat");
+    std::string label;
+    if (!(stat >> label) || label != "cpu") {
+        return std::nullopt;
+    }
+    // user nice system idle iowait irq softirq steal; idle and iowait are not busy.
+    CpuTimes times;
+    for (int field = 0; field < 8; ++field) {
+        std::uint64_t value = 0;
+        if (!(stat >> value)) {
+            return std::nullopt;
+        }
+        times.total += value;
+        if (field != 3 && field != 4) {
+            times.busy += value;
+        }
+    }
+    return times;
+}
+
+// Fraction of CPU time spent busy between two samples, in [0, 1].
+inline auto Utilization(const CpuTimes& before, const CpuTimes& after) -> double {
+    if (after.total <= before.total) {
+        return 0.0;
+    }
+    return static_cast<double>(after.busy - before.busy) /
+           static_cast<double>(after.total - before.total);
+}
+
+// One measurement interval of a running pool.
+struct Observation {
+    double throughput;  // completed tests per second
+    double cpu;         // machine-wide CPU utilization, 0..1
+    double load;        // one-minute load average
+};
+
+// Hill-climbing controller for the number of worker processes.
+//
+// Each interval it compares throughput with the previous one. A step that raised
+// throughput is repeated in the same direction, a step that lowered it is undone and the
+// direction reversed, followed by a few intervals of rest. Otherwise idle CPUs invite
+// growth (sleep- and IO-heavy tests want more workers than cores) and a load average
+// well above the core count invites a shrink; every few quiet intervals it probes one
+// step in the current direction, so the count follows tests whose behaviour changes
+// during the run.
+class WorkerTuner {
+   public:
+    static constexpr double kTolerance = 0.05;  // relative throughput change worth acting on
+    static constexpr double kBusy = 0.90;       // CPU utilization considered saturated
+    static constexpr double kOverload = 1.5;    // load average per core considered overloaded
+    static constexpr int kProbeEvery = 4;       // quiet intervals between probing steps
+
+    struct Decision {
+        std::size_t workers;
+        std::string reason;  // empty when the count is unchanged
+    };
+
+    WorkerTuner(std::size_t initial, std::size_t min_workers, std::size_t max_workers,
+                std::size_t cores)
+        : min_(std::max<std::size_t>(min_workers, 1)),
+          max_(std::max(max_workers, min_)),
+          cores_(std::max<std::size_t>(cores, 1)),
+          workers_(std::clamp(initial, min_, max_)) {}
+
+    [[nodiscard]] auto Workers() const -> std::size_t {
+        return workers_;
+    }
+
+    // Feeds the measurements of an interval run at Workers() workers.
+    auto Update(const Observation& obs) -> Decision {
+        auto previous = last_throughput_;
+        last_throughput_ = obs.throughput;
+
+        if (stepped_from_ && previous) {
+            auto from = *stepped_from_;
+            stepped_from_.reset();
+            if (obs.throughput < *previous * (1 - kTolerance)) {
+                direction_ = -direction_;
+                quiet_ = -kProbeEvery;  // let the reverted count settle before probing again
+                return Move(from, std::format("throughput fell to {:.1f}/s, reverting",
+                                              obs.throughput));
+            }
+            if (obs.throughput > *previous * (1 + kTolerance)) {
+                return Step(std::format("throughput rose to {:.1f}/s", obs.throughput));
+            }
+        }
+
+        if (quiet_ < 0) {
+            ++quiet_;
+            return {.workers = workers_, .reason = {}};
+        }
+        if (obs.load > kOverload * static_cast<double>(cores_) && workers_ > min_) {
+            direction_ = -1;
+            return Step(std::format("load {:.1f} on {} cores", obs.load, cores_));
+        }
+        if (obs.cpu < kBusy && workers_ < max_) {
+            direction_ = 1;
+            return Step(std::format("cpu {:.0f}% busy", obs.cpu * 100));
+        }
+        if (++quiet_ >= kProbeEvery) {
+            return Step("probing");
+        }
+        return {.workers = workers_, .reason = {}};
+    }
+
+   private:
+    std::size_t min_;
+    std::size_t max_;
+    std::size_t cores_;
+    std::size_t workers_;
+    int direction_ = 1;
+    int quiet_ = 0;
+    std::optional<double> last_throughput_;
+    std::optional<std::size_t> stepped_from_;
+
+    // Moves a quarter of the current count (at least one) in the current direction.
+    auto Step(std::string reason) -> Decision {
+        auto step = std::max<std::size_t>(workers_ / 4, 1);
+        auto target = direction_ > 0 ? std::min(workers_ + step, max_)
+                                     : std::max(workers_ - std::min(step, workers_), min_);
+        if (target == workers_) {
+            direction_ = -direction_;  // hit a bound; probe the other way next time
+            return {.workers = workers_, .reason = {}};
+        }
+        stepped_from_ = workers_;
+        return Move(target, std::move(reason));
+    }
+
+    auto Move(std::size_t target, std::string reason) -> Decision {
+        quiet_ = std::min(quiet_, 0);
+        workers_ = target;
+        return {.workers = workers_, .reason = std::move(reason)};
+    }
+};
+
+}  // namespace flul::test
+
+#endif  // FLUL_TEST_WORKER_TUNER_HPP_
@@ -1,7 +1,9 @@
 #include "flul/test/assertion_error.hpp"
 
+#include <optional>
 #include <source_location>
 #include <string>
+#include <utility>
 
 #include "flul/test/expect.hpp"
 #include "flul/test/registry.hpp"
@@ -34,11 +36,30 @@ class AssertionErrorSuite : public Suite<AssertionErrorSuite> {
         Expect(err.location.line()).ToEqual(loc.line());
     }
 
+    void TestWhatCachesMessage() {
+        AssertionError err("got", "want", std::source_location::current());
+        const char* first = err.what();
+        Expect(std::string(first)).ToEqual(err.Message());
+        Expect(err.what() == first).ToBeTrue();  // formatted once
+    }
+
+    void TestMovedIntoResult() {
+        auto loc = std::source_location::current();
+        AssertionError err("got", "want", loc);
+        std::optional<AssertionError> stored(std::move(err));
+
+        Expect(stored->actual).ToEqual(std::string("got"));
+        Expect(stored->Message().contains("expected: want")).ToBeTrue();
+        Expect(stored->location.line()).ToEqual(loc.line());
+    }
+
     static void Register(Registry& r) {
         AddTests(r, "AssertionErrorSuite",
                  {
                      {"TestWhatFormat", &AssertionErrorSuite::TestWhatFormat},
                      {"TestPublicFields", &AssertionErrorSuite::TestPublicFields},
+                     {"TestWhatCachesMessage", &AssertionErrorSuite::TestWhatCachesMessage},
+                     {"TestMovedIntoResult", &AssertionErrorSuite::TestMovedIntoResult},
                  });
     }
 };
@@ -0,0 +1,149 @@
+#include "flul/test/bisect.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::Expect;
+using flul::test::PolluterBisection;
+using flul::test::Registry;
+using flul::test::Suite;
+
+namespace {
+
+// Global state the fixtures below leak into each other. Only ever modified inside the
+// forked probe processes.
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+bool g_first_half = false;
+bool g_second_half = false;
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+class PollutingSuite : public Suite<PollutingSuite> {
+   public:
+    void Innocent() {}
+
+    void SetBoth() {
+        g_first_half = true;
+        g_second_half = true;
+    }
+
+    void SetFirst() {
+        g_first_half = true;
+    }
+
+    void SetSecond() {
+        g_second_half = true;
+    }
+
+    void Victim() {
+        Expect(g_first_half && g_second_half).ToBeFalse();
+    }
+
+    void Broken() {
+        Expect(1).ToEqual(2);
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static)
+
+// Registers `count` innocent tests, with `polluters` spliced in at the given positions,
+// followed by the victim test.
+auto MakeRegistry(std::size_t count,
+                  std::initializer_list<std::pair<std::size_t, void (PollutingSuite::*)()>>
+                      polluters,
+                  void (PollutingSuite::*victim)() = &PollutingSuite::Victim) -> Registry {
+    // Test names must outlive the registry; a deque never moves its elements.
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    static std::deque<std::string> names;
+    Registry reg;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto method = &PollutingSuite::Innocent;
+        for (const auto& [position, polluter] : polluters) {
+            if (position == i) {
+                method = polluter;
+            }
+        }
+        if (names.size() <= i) {
+            names.push_back("Test" + std::to_string(i));
+        }
+        reg.Add<PollutingSuite>("Polluting", names[i], method);
+    }
+    reg.Add<PollutingSuite>("Polluting", "Victim", victim);
+    return reg;
+}
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class BisectSuite : public Suite<BisectSuite> {
+   public:
+    void TestFindsSinglePolluter() {
+        auto reg = MakeRegistry(40, {{23, &PollutingSuite::SetBoth}});
+        PolluterBisection bisection(reg.Tests(), 40, 4);
+        auto outcome = bisection.Run();
+        Expect(outcome.kind == PolluterBisection::Outcome::Kind::kFound).ToBeTrue();
+        Expect(outcome.polluters.size()).ToEqual(std::size_t{1});
+        Expect(outcome.polluters[0]).ToEqual(std::size_t{23});
+    }
+
+    void TestFindsPollutingPair() {
+        auto reg =
+            MakeRegistry(30, {{5, &PollutingSuite::SetFirst}, {17, &PollutingSuite::SetSecond}});
+        PolluterBisection bisection(reg.Tests(), 30, 4);
+        auto outcome = bisection.Run();
+        Expect(outcome.kind == PolluterBisection::Outcome::Kind::kFound).ToBeTrue();
+        Expect(outcome.polluters.size()).ToEqual(std::size_t{2});
+        Expect(outcome.polluters[0]).ToEqual(std::size_t{5});
+        Expect(outcome.polluters[1]).ToEqual(std::size_t{17});
+    }
+
+    void TestFailsAlone() {
+        auto reg = MakeRegistry(3, {}, &PollutingSuite::Broken);
+        PolluterBisection bisection(reg.Tests(), 3, 2);
+        auto outcome = bisection.Run();
+        Expect(outcome.kind == PolluterBisection::Outcome::Kind::kFailsAlone).ToBeTrue();
+    }
+
+    void TestNotReproduced() {
+        auto reg = MakeRegistry(5, {});
+        PolluterBisection bisection(reg.Tests(), 5, 2);
+        auto outcome = bisection.Run();
+        Expect(outcome.kind == PolluterBisection::Outcome::Kind::kNotReproduced).ToBeTrue();
+    }
+
+    void TestParallelRounds() {
+        // With 7 probes per round, 64 candidates need two prefix rounds at most.
+        auto reg = MakeRegistry(64, {{50, &PollutingSuite::SetBoth}});
+        PolluterBisection bisection(reg.Tests(), 64, 7);
+        auto outcome = bisection.Run();
+        Expect(outcome.polluters.size()).ToEqual(std::size_t{1});
+        Expect(outcome.rounds).ToBeLessThan(std::size_t{6});
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "BisectSuite",
+                 {
+                     {"TestFindsSinglePolluter", &BisectSuite::TestFindsSinglePolluter},
+                     {"TestFindsPollutingPair", &BisectSuite::TestFindsPollutingPair},
+                     {"TestFailsAlone", &BisectSuite::TestFailsAlone},
+                     {"TestNotReproduced", &BisectSuite::TestNotReproduced},
+                     {"TestParallelRounds", &BisectSuite::TestParallelRounds},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace bisect_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    BisectSuite::Register(r);
+}
+}  // namespace bisect_test
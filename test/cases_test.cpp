@@ -0,0 +1,147 @@
+#include "flul/test/cases.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/expect_callable.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::Expect;
+using flul::test::ExpectCallable;
+using flul::test::GenerateCases;
+using flul::test::LineCases;
+using flul::test::Registry;
+using flul::test::Suite;
+
+namespace {
+
+std::vector<int> g_seen;           // parameters received by ParamSuite::Record
+std::size_t g_generated = 0;       // calls to the generator in TestGeneratedLazily
+std::vector<std::string> g_lines;  // parameters received by ParamSuite::RecordLine
+
+class ParamSuite : public Suite<ParamSuite> {
+   public:
+    void Record(int value) {
+        g_seen.push_back(value);
+    }
+
+    void RecordLine(const std::string& line) {
+        g_lines.push_back(line);
+    }
+};
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class CasesSuite : public Suite<CasesSuite> {
+   public:
+    void TestEachCaseIsAnEntry() {
+        Registry reg;
+        reg.AddParameterized("Param", "Square", &ParamSuite::Record,
+                             std::views::iota(0, 5) | std::views::transform([](int i) {
+                                 return i * i;
+                             }));
+        Expect(reg.Tests().size()).ToEqual(std::size_t{5});
+        Expect(reg.Tests()[0].test_name).ToEqual(std::string_view("Square/0"));
+        Expect(reg.Tests()[4].test_name).ToEqual(std::string_view("Square/4"));
+
+        g_seen.clear();
+        reg.Tests()[3].callable();
+        reg.Tests()[1].callable();
+        Expect(g_seen).ToEqual(std::vector<int>{9, 1});
+    }
+
+    void TestGeneratedLazily() {
+        g_generated = 0;
+        Registry reg;
+        reg.AddParameterized("Param", "Gen", &ParamSuite::Record,
+                             GenerateCases(1000, [](std::size_t i) {
+                                 ++g_generated;
+                                 return static_cast<int>(i) * 2;
+                             }));
+        Expect(reg.Tests().size()).ToEqual(std::size_t{1000});
+        Expect(g_generated).ToEqual(std::size_t{0});
+
+        g_seen.clear();
+        reg.Tests()[700].callable();
+        Expect(g_generated).ToEqual(std::size_t{1});
+        Expect(g_seen).ToEqual(std::vector<int>{1400});
+    }
+
+    void TestCasesAreFilterable() {
+        Registry reg;
+        reg.AddParameterized("Param", "Value", &ParamSuite::Record, std::vector<int>{5, 6, 7});
+        const std::vector<std::string_view> names = {"Param::Value/2"};
+        Expect(reg.Select(names).empty()).ToBeTrue();
+        Expect(reg.Tests().size()).ToEqual(std::size_t{1});
+
+        g_seen.clear();
+        reg.Tests()[0].callable();
+        Expect(g_seen).ToEqual(std::vector<int>{7});
+    }
+
+    void TestCopiesShareCases() {
+        Registry copy;
+        {
+            Registry reg;
+            reg.AddParameterized("Param", "Value", &ParamSuite::Record, std::vector<int>{4, 2});
+            copy = reg;
+        }
+        g_seen.clear();
+        copy.Tests()[1].callable();
+        Expect(copy.Tests()[1].test_name).ToEqual(std::string_view("Value/1"));
+        Expect(g_seen).ToEqual(std::vector<int>{2});
+    }
+
+    void TestLineCases() {
+        auto path = std::filesystem::temp_directory_path() / "flul_line_cases.txt";
+        {
+            std::ofstream table(path);
+            table << "# inputs\n  alpha  \r\n\nbeta\ngamma";
+        }
+        Registry reg;
+        reg.AddParameterized("Param", "Line", &ParamSuite::RecordLine, LineCases(path.string()));
+        Expect(reg.Tests().size()).ToEqual(std::size_t{3});
+
+        g_lines.clear();
+        for (const auto& test : reg.Tests()) {
+            test.callable();
+        }
+        std::filesystem::remove(path);
+        Expect(g_lines).ToEqual(std::vector<std::string>{"alpha", "beta", "gamma"});
+    }
+
+    void TestLineCasesMissingFile() {
+        ExpectCallable([] {
+            LineCases cases("/nonexistent/flul_cases.txt");
+        }).ToThrow<std::runtime_error>();
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "CasesSuite",
+                 {
+                     {"TestEachCaseIsAnEntry", &CasesSuite::TestEachCaseIsAnEntry},
+                     {"TestGeneratedLazily", &CasesSuite::TestGeneratedLazily},
+                     {"TestCasesAreFilterable", &CasesSuite::TestCasesAreFilterable},
+                     {"TestCopiesShareCases", &CasesSuite::TestCopiesShareCases},
+                     {"TestLineCases", &CasesSuite::TestLineCases},
+                     {"TestLineCasesMissingFile", &CasesSuite::TestLineCasesMissingFile},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace cases_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    CasesSuite::Register(r);
+}
+}  // namespace cases_test
@@ -0,0 +1,103 @@
+#include "flul/test/dependencies.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::DependencyTracker;
+using flul::test::Expect;
+using flul::test::Registry;
+using flul::test::Suite;
+
+namespace {
+
+using Ids = std::vector<std::uint32_t>;
+
+// 0 <- 1 <- 3, 0 <- 2, 4 independent.
+auto Diamondish() -> std::vector<Ids> {
+    return {{}, {0}, {0}, {1}, {}};
+}
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class DependenciesSuite : public Suite<DependenciesSuite> {
+   public:
+    void TestInitialWithoutPrerequisites() {
+        DependencyTracker graph(3, {});
+        Expect(graph.Initial() == Ids{0, 1, 2}).ToBeTrue();
+    }
+
+    void TestReleasesDependents() {
+        auto prerequisites = Diamondish();
+        DependencyTracker graph(prerequisites.size(), prerequisites);
+        Expect(graph.Initial() == Ids{0, 4}).ToBeTrue();
+        auto update = graph.Complete(0, true);
+        Expect(update.ready == Ids{1, 2}).ToBeTrue();
+        Expect(update.skipped.empty()).ToBeTrue();
+        Expect(graph.Complete(1, true).ready == Ids{3}).ToBeTrue();
+    }
+
+    void TestWaitsForAllPrerequisites() {
+        std::vector<Ids> prerequisites{{}, {}, {0, 1}};
+        DependencyTracker graph(prerequisites.size(), prerequisites);
+        Expect(graph.Complete(0, true).ready.empty()).ToBeTrue();
+        Expect(graph.Complete(1, true).ready == Ids{2}).ToBeTrue();
+    }
+
+    void TestFailureSkipsTransitively() {
+        auto prerequisites = Diamondish();
+        DependencyTracker graph(prerequisites.size(), prerequisites);
+        auto update = graph.Complete(0, false);
+        Expect(update.ready.empty()).ToBeTrue();
+        Expect(update.skipped.size()).ToEqual(std::size_t{3});
+        Expect(graph.Cause(3)).ToEqual(std::uint32_t{0});
+        Expect(graph.Cause(4)).ToEqual(DependencyTracker::kNone);
+    }
+
+    void TestOrderFollowsPrerequisites() {
+        std::vector<Ids> prerequisites{{2}, {}, {}, {0}};
+        DependencyTracker graph(prerequisites.size(), prerequisites);
+        Expect(graph.Order() == Ids{1, 2, 0, 3}).ToBeTrue();
+    }
+
+    void TestSkippedResultCarriesId() {
+        auto method = &DependenciesSuite::TestOrderFollowsPrerequisites;
+        Registry reg;
+        reg.Add<DependenciesSuite>("Build", "Artifact", method);
+        reg.Add<DependenciesSuite>("Read", "Artifact", method);
+        auto result = flul::test::SkippedResult(reg.Tests(), 1, 0);
+        Expect(result.id).ToEqual(std::uint32_t{1});
+        Expect(result.suite_name).ToEqual(std::string_view("Read"));
+        Expect(*result.skipped).ToEqual(std::string("prerequisite Build::Artifact did not pass"));
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "DependenciesSuite",
+                 {
+                     {"TestInitialWithoutPrerequisites",
+                      &DependenciesSuite::TestInitialWithoutPrerequisites},
+                     {"TestReleasesDependents", &DependenciesSuite::TestReleasesDependents},
+                     {"TestWaitsForAllPrerequisites",
+                      &DependenciesSuite::TestWaitsForAllPrerequisites},
+                     {"TestFailureSkipsTransitively",
+                      &DependenciesSuite::TestFailureSkipsTransitively},
+                     {"TestOrderFollowsPrerequisites",
+                      &DependenciesSuite::TestOrderFollowsPrerequisites},
+                     {"TestSkippedResultCarriesId", &DependenciesSuite::TestSkippedResultCarriesId},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace dependencies_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    DependenciesSuite::Register(r);
+}
+}  // namespace dependencies_test
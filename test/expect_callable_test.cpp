@@ -1,5 +1,8 @@
 #include "flul/test/expect_callable.hpp"
 
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
 #include <stdexcept>
 
 #include "flul/test/assertion_error.hpp"
@@ -46,6 +49,50 @@ class ExpectCallableSuite : public Suite<ExpectCallableSuite> {
         }).ToThrow<AssertionError>();
     }
 
+    void TestToAbortPass() {
+        ExpectCallable([] { std::abort(); }).ToAbort();
+    }
+
+    void TestToAbortReturns() {
+        ExpectCallable([] { ExpectCallable([] {}).ToAbort(); }).ToThrow<AssertionError>();
+    }
+
+    void TestToAbortMatchesStderr() {
+        ExpectCallable([] {
+            std::fputs("fatal: index 7 out of range\n", stderr);
+            std::abort();
+        }).ToAbort("index [0-9]+ out of range");
+    }
+
+    void TestToAbortStderrMismatch() {
+        ExpectCallable([] {
+            ExpectCallable([] {
+                std::fputs("something else\n", stderr);
+                std::abort();
+            }).ToAbort("out of range");
+        }).ToThrow<AssertionError>();
+    }
+
+    void TestToExitWithPass() {
+        ExpectCallable([] { std::exit(3); }).ToExitWith(3);  // NOLINT(concurrency-mt-unsafe)
+    }
+
+    void TestToExitWithWrongCode() {
+        ExpectCallable([] {
+            ExpectCallable([] { std::exit(4); }).ToExitWith(3);  // NOLINT(concurrency-mt-unsafe)
+        }).ToThrow<AssertionError>();
+    }
+
+    void TestToDieWithSignalPass() {
+        ExpectCallable([] { std::raise(SIGTERM); }).ToDieWithSignal(SIGTERM);
+    }
+
+    void TestToDieWithSignalThrows() {
+        ExpectCallable([] {
+            ExpectCallable([] { throw std::runtime_error("no death"); }).ToDieWithSignal(SIGTERM);
+        }).ToThrow<AssertionError>();
+    }
+
     static void Register(Registry& r) {
         AddTests(
             r, "ExpectCallableSuite",
@@ -57,6 +104,14 @@ class ExpectCallableSuite : public Suite<ExpectCallableSuite> {
                 {"TestToNotThrowStdException", &ExpectCallableSuite::TestToNotThrowStdException},
                 {"TestToNotThrowUnknownException",
                  &ExpectCallableSuite::TestToNotThrowUnknownException},
+                {"TestToAbortPass", &ExpectCallableSuite::TestToAbortPass},
+                {"TestToAbortReturns", &ExpectCallableSuite::TestToAbortReturns},
+                {"TestToAbortMatchesStderr", &ExpectCallableSuite::TestToAbortMatchesStderr},
+                {"TestToAbortStderrMismatch", &ExpectCallableSuite::TestToAbortStderrMismatch},
+                {"TestToExitWithPass", &ExpectCallableSuite::TestToExitWithPass},
+                {"TestToExitWithWrongCode", &ExpectCallableSuite::TestToExitWithWrongCode},
+                {"TestToDieWithSignalPass", &ExpectCallableSuite::TestToDieWithSignalPass},
+                {"TestToDieWithSignalThrows", &ExpectCallableSuite::TestToDieWithSignalThrows},
             });
     }
 };
@@ -0,0 +1,139 @@
+#include "flul/test/filter.hpp"
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/expect_callable.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::Expect;
+using flul::test::ExpectCallable;
+using flul::test::NamePatterns;
+using flul::test::Registry;
+using flul::test::Suite;
+using flul::test::TestEntry;
+using flul::test::TestFilter;
+
+namespace {
+
+auto Compile(std::initializer_list<std::string_view> patterns) -> NamePatterns {
+    return NamePatterns(std::span<const std::string_view>(patterns.begin(), patterns.size()));
+}
+
+void Noop(const flul::test::TestCallable& /*self*/) {}
+
+auto Entry(std::string_view suite, std::string_view test) -> TestEntry {
+    return {.suite_name = suite, .test_name = test, .callable = {.invoke = &Noop}};
+}
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class FilterSuite : public Suite<FilterSuite> {
+   public:
+    void TestPlainPatternIsSubstring() {
+        auto patterns = Compile({"Math::Add"});
+        Expect(patterns.Matches("Math", "Add")).ToBeTrue();
+        Expect(patterns.Matches("Math", "Addition")).ToBeTrue();
+        Expect(patterns.Matches("BigMath", "Add")).ToBeTrue();
+        Expect(patterns.Matches("Math", "Sub")).ToBeFalse();
+    }
+
+    void TestGlobMatchesWholeName() {
+        auto patterns = Compile({"Math*::Test?"});
+        Expect(patterns.Matches("MathSuite", "TestA")).ToBeTrue();
+        Expect(patterns.Matches("Math", "Test1")).ToBeTrue();
+        Expect(patterns.Matches("MathSuite", "TestAB")).ToBeFalse();
+        Expect(patterns.Matches("BigMath", "TestA")).ToBeFalse();
+    }
+
+    void TestGlobClass() {
+        auto patterns = Compile({"S::T[0-2]", "S::U[!ab]"});
+        Expect(patterns.Matches("S", "T1")).ToBeTrue();
+        Expect(patterns.Matches("S", "T3")).ToBeFalse();
+        Expect(patterns.Matches("S", "Uc")).ToBeTrue();
+        Expect(patterns.Matches("S", "Ua")).ToBeFalse();
+    }
+
+    void TestRegexSearchesAndAnchors() {
+        auto found = Compile({"re:(Add|Sub)+tract"});
+        Expect(found.Matches("Math", "TestSubtract")).ToBeTrue();
+        Expect(found.Matches("Math", "TestAddSubtraction")).ToBeTrue();
+        Expect(found.Matches("Math", "TestMultiply")).ToBeFalse();
+
+        auto anchored = Compile({"re:^Math::[A-Z][a-z]*$"});
+        Expect(anchored.Matches("Math", "Add")).ToBeTrue();
+        Expect(anchored.Matches("Math", "AddMore")).ToBeFalse();
+        Expect(anchored.Matches("BigMath", "Add")).ToBeFalse();
+
+        auto literal = Compile({"re:cost\\$"});
+        Expect(literal.Matches("S", "cost$1")).ToBeTrue();
+        Expect(literal.Matches("S", "cost")).ToBeFalse();
+    }
+
+    void TestRejectsMalformedPatterns() {
+        for (auto pattern : {"re:(a", "re:a)", "re:*a", "re:a\\", "S::[a", "re:[z-a]"}) {
+            ExpectCallable([pattern] { Compile({pattern}); }).ToThrow<std::invalid_argument>();
+        }
+    }
+
+    void TestCacheFlushKeepsResults() {
+        // The 12th character from the end being 'a' needs 2^12 DFA states, well past the
+        // cache bound, so matching restarts the cache many times.
+        auto patterns = Compile({"re:a[ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab]$"});
+        for (unsigned bits = 0; bits < 4096; bits += 7) {
+            std::string name;
+            for (unsigned b = 12; b-- > 0;) {
+                name += ((bits >> b) & 1U) != 0 ? 'a' : 'b';
+            }
+            Expect(patterns.Matches("S", name)).ToEqual(((bits >> 11U) & 1U) != 0);
+        }
+    }
+
+    void TestFilterIncludesAndExcludes() {
+        const std::array<std::string_view, 2> includes = {"Math::*", "re:^Str"};
+        const std::array<std::string_view, 1> excludes = {"Slow"};
+        TestFilter filter(includes, excludes);
+        Expect(filter.Selects(Entry("Math", "Add"))).ToBeTrue();
+        Expect(filter.Selects(Entry("Math", "AddSlow"))).ToBeFalse();
+        Expect(filter.Selects(Entry("String", "Split"))).ToBeTrue();
+        Expect(filter.Selects(Entry("Io", "Read"))).ToBeFalse();
+    }
+
+    void TestExcludeOnly() {
+        const std::array<std::string_view, 1> excludes = {"Io::*"};
+        TestFilter filter({}, excludes);
+        Expect(filter.Selects(Entry("Math", "Add"))).ToBeTrue();
+        Expect(filter.Selects(Entry("Io", "Read"))).ToBeFalse();
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "FilterSuite",
+                 {
+                     {"TestPlainPatternIsSubstring", &FilterSuite::TestPlainPatternIsSubstring},
+                     {"TestGlobMatchesWholeName", &FilterSuite::TestGlobMatchesWholeName},
+                     {"TestGlobClass", &FilterSuite::TestGlobClass},
+                     {"TestRegexSearchesAndAnchors", &FilterSuite::TestRegexSearchesAndAnchors},
+                     {"TestRejectsMalformedPatterns", &FilterSuite::TestRejectsMalformedPatterns},
+                     {"TestCacheFlushKeepsResults", &FilterSuite::TestCacheFlushKeepsResults},
+                     {"TestFilterIncludesAndExcludes",
+                      &FilterSuite::TestFilterIncludesAndExcludes},
+                     {"TestExcludeOnly", &FilterSuite::TestExcludeOnly},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace filter_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    FilterSuite::Register(r);
+}
+}  // namespace filter_test
@@ -0,0 +1,161 @@
+#include "flul/test/fuzz.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/output_capture.hpp"
+#include "flul/test/registry.hpp"
+#include "flul/test/run.hpp"
+
+using flul::test::Expect;
+using flul::test::FuzzOptions;
+using flul::test::Mutate;
+using flul::test::OutputCapture;
+using flul::test::Registry;
+using flul::test::SplitMix64;
+using flul::test::Suite;
+
+namespace {
+
+std::vector<std::size_t> g_sizes;  // input sizes seen by FuzzSuite::Record
+std::size_t g_runs = 0;            // calls to FuzzSuite::Count
+
+class FuzzSuite : public Suite<FuzzSuite> {
+   public:
+    void Record(std::span<const std::byte> input) {
+        g_sizes.push_back(input.size());
+    }
+
+    void Count(std::span<const std::byte> /*input*/) {
+        ++g_runs;
+    }
+
+    void RejectFf(std::span<const std::byte> input) {
+        if (std::ranges::find(input, std::byte{0xff}) != input.end()) {
+            throw std::runtime_error("0xff in input");
+        }
+    }
+};
+
+// A fresh, empty directory under the system temporary directory.
+auto MakeTempDirectory(std::string_view name) -> std::filesystem::path {
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directory(path);
+    return path;
+}
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class FuzzTestSuite : public Suite<FuzzTestSuite> {
+   public:
+    void TestCorpusReplaysAsCases() {
+        auto corpus = MakeTempDirectory("flul_fuzz_corpus");
+        std::ofstream(corpus / "b") << "four";
+        std::ofstream(corpus / "a") << "12";
+        Registry reg;
+        reg.AddFuzzTarget("Fuzz", "Parse", &FuzzSuite::Record, corpus.string());
+        Expect(reg.Tests().size()).ToEqual(std::size_t{2});
+        Expect(reg.Tests()[1].test_name).ToEqual(std::string_view("Parse/1"));
+
+        g_sizes.clear();
+        for (const auto& test : reg.Tests()) {
+            test.callable();
+        }
+        std::filesystem::remove_all(corpus);
+        Expect(g_sizes).ToEqual(std::vector<std::size_t>{2, 4});  // file name order
+    }
+
+    void TestFindFuzzTarget() {
+        Registry reg;
+        reg.AddFuzzTarget("Fuzz", "Parse", &FuzzSuite::Record, "/nonexistent/flul_corpus");
+        Expect(reg.Tests().empty()).ToBeTrue();
+        Expect(reg.FuzzTargets().size()).ToEqual(std::size_t{1});
+        Expect(reg.FindFuzzTarget("Fuzz::Parse") != nullptr).ToBeTrue();
+        Expect(reg.FindFuzzTarget("Fuzz::Pars") == nullptr).ToBeTrue();
+    }
+
+    void TestFuzzStopsAfterRuns() {
+        Registry reg;
+        reg.AddFuzzTarget("Fuzz", "Count", &FuzzSuite::Count);
+        g_runs = 0;
+        auto status = flul::test::Fuzz(reg.FuzzTargets()[0], {}, {.runs = 1000});
+        Expect(status).ToEqual(0);
+        Expect(g_runs).ToEqual(std::size_t{1001});  // the empty seed input, then 1000 mutants
+    }
+
+    void TestFuzzSavesFailingInput() {
+        auto crashes = MakeTempDirectory("flul_fuzz_crashes");
+        Registry reg;
+        reg.AddFuzzTarget("Fuzz", "RejectFf", &FuzzSuite::RejectFf);
+        const FuzzOptions options{.runs = 100000, .seed = 1, .crash_directory = crashes};
+        Expect(flul::test::Fuzz(reg.FuzzTargets()[0], {}, options)).ToEqual(1);
+
+        const std::vector<std::filesystem::path> saved{
+            std::filesystem::directory_iterator(crashes), std::filesystem::directory_iterator()};
+        Expect(saved.size()).ToEqual(std::size_t{1});
+        std::ifstream file(saved.front(), std::ios::binary);
+        std::vector<char> input(std::istreambuf_iterator<char>(file), {});
+        std::filesystem::remove_all(crashes);
+        Expect(std::ranges::find(input, '\xff') != input.end()).ToBeTrue();
+    }
+
+    void TestSeedFlagIsUsedAndPrinted() {
+        Registry reg;
+        reg.AddFuzzTarget("Fuzz", "Count", &FuzzSuite::Count);
+        std::vector<char*> argv;
+        for (const char* arg : {"prog", "--fuzz", "Fuzz::Count", "--fuzz-runs", "10",
+                                "--fuzz-seed", "0x2a"}) {
+            argv.push_back(const_cast<char*>(arg));  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        }
+        g_runs = 0;
+        OutputCapture capture(4096);
+        auto status = flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg);
+        auto text = capture.Finish();
+        Expect(status).ToEqual(0);
+        Expect(g_runs).ToEqual(std::size_t{11});
+        Expect(text.starts_with("fuzz: Fuzz::Count with seed 0x2a\n")).ToBeTrue();
+    }
+
+    void TestMutateRespectsMaxLength() {
+        SplitMix64 rng(7);
+        const std::vector<std::vector<std::byte>> corpus = {std::vector<std::byte>(32)};
+        std::vector<std::byte> input;
+        for (int i = 0; i < 10000; ++i) {
+            Mutate(input, rng, corpus, 16);
+            Expect(input.size() <= 16).ToBeTrue();
+        }
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "FuzzTestSuite",
+                 {
+                     {"TestCorpusReplaysAsCases", &FuzzTestSuite::TestCorpusReplaysAsCases},
+                     {"TestFindFuzzTarget", &FuzzTestSuite::TestFindFuzzTarget},
+                     {"TestFuzzStopsAfterRuns", &FuzzTestSuite::TestFuzzStopsAfterRuns},
+                     {"TestFuzzSavesFailingInput", &FuzzTestSuite::TestFuzzSavesFailingInput},
+                     {"TestSeedFlagIsUsedAndPrinted",
+                      &FuzzTestSuite::TestSeedFlagIsUsedAndPrinted},
+                     {"TestMutateRespectsMaxLength", &FuzzTestSuite::TestMutateRespectsMaxLength},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace fuzz_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    FuzzTestSuite::Register(r);
+}
+}  // namespace fuzz_test
@@ -0,0 +1,114 @@
+#include "flul/test/manifest.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/output_capture.hpp"
+#include "flul/test/registry.hpp"
+#include "flul/test/run.hpp"
+#include "flul/test/static_tests.hpp"
+
+using flul::test::Expect;
+using flul::test::JoinTables;
+using flul::test::Manifest;
+using flul::test::ManifestEntry;
+using flul::test::ManifestTests;
+using flul::test::OutputCapture;
+using flul::test::Registry;
+using flul::test::StaticTest;
+using flul::test::Suite;
+
+namespace {
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+int g_runs = 0;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+class ManifestSampleSuite : public Suite<ManifestSampleSuite> {
+   public:
+    void Read() {
+        ++g_runs;
+    }
+
+    void Write() {
+        ++g_runs;
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static)
+
+constexpr std::array kSampleManifest = {
+    ManifestEntry{StaticTest<&ManifestSampleSuite::Read>("ManifestSampleSuite", "Read"),
+                  "io,slow", 30, 5},
+    ManifestEntry{StaticTest<&ManifestSampleSuite::Write>("ManifestSampleSuite", "Write")},
+};
+FLUL_TEST_MANIFEST(kSampleManifest);
+
+constexpr auto kSampleTests = ManifestTests(kSampleManifest);
+
+constexpr std::string_view kSampleText =
+    "ManifestSampleSuite::Read\tio,slow\t30\t5\n"
+    "ManifestSampleSuite::Write\t\t0\t0\n";
+
+static_assert(std::string_view(kSampleManifest_manifest_text.data(),
+                               kSampleManifest_manifest_text.size()) == kSampleText);
+static_assert(JoinTables(kSampleTests).size() == 2);
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class ManifestSuite : public Suite<ManifestSuite> {
+   public:
+    void TestBinaryContainsManifest() {
+        Expect(Manifest().contains(kSampleText)).ToBeTrue();
+    }
+
+    void TestManifestTestsRun() {
+        Registry reg(kSampleTests);
+        g_runs = 0;
+        for (const auto& test : reg.Tests()) {
+            test.callable();
+        }
+        Expect(reg.Tests()[1].test_name).ToEqual(std::string_view("Write"));
+        Expect(g_runs).ToEqual(2);
+    }
+
+    void TestTagsSelectManifestTests() {
+        Registry reg;
+        reg.AddManifest(kSampleManifest);
+        Expect(reg.TagNames().size()).ToEqual(std::size_t{2});
+
+        std::vector<char*> argv;
+        for (const auto* arg : {"prog", "--tags", "slow", "--list", "--with-tags"}) {
+            argv.push_back(const_cast<char*>(arg));  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        }
+        OutputCapture capture(4096);
+        auto status = flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg);
+        auto text = capture.Finish();
+        Expect(status).ToEqual(0);
+        Expect(text).ToEqual(std::string("ManifestSampleSuite::Read\tio,slow\n"));
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "ManifestSuite",
+                 {
+                     {"TestBinaryContainsManifest", &ManifestSuite::TestBinaryContainsManifest},
+                     {"TestManifestTestsRun", &ManifestSuite::TestManifestTestsRun},
+                     {"TestTagsSelectManifestTests", &ManifestSuite::TestTagsSelectManifestTests},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace manifest_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    ManifestSuite::Register(r);
+}
+}  // namespace manifest_test
@@ -0,0 +1,171 @@
+#include "flul/test/matrix.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/expect_callable.hpp"
+#include "flul/test/output_capture.hpp"
+#include "flul/test/registry.hpp"
+#include "flul/test/runner.hpp"
+
+using flul::test::CombinationTable;
+using flul::test::Expect;
+using flul::test::ExpectCallable;
+using flul::test::OutputCapture;
+using flul::test::PairwiseCases;
+using flul::test::ProductCases;
+using flul::test::Registry;
+using flul::test::Runner;
+using flul::test::Suite;
+
+namespace {
+
+using Config = std::tuple<int, std::string, bool>;
+
+std::vector<Config> g_configs;  // parameters received by ConfigSuite::Record
+
+class ConfigSuite : public Suite<ConfigSuite> {
+   public:
+    void Record(Config config) {
+        g_configs.push_back(std::move(config));
+    }
+};
+
+// Every row of `table`.
+auto AllRows(const CombinationTable& table) -> std::vector<std::uint32_t> {
+    std::vector<std::uint32_t> rows(table.size());
+    std::iota(rows.begin(), rows.end(), 0U);
+    return rows;
+}
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class MatrixSuite : public Suite<MatrixSuite> {
+   public:
+    void TestProductVariesLastDimensionFastest() {
+        auto cases = ProductCases(std::vector{1, 2}, std::vector<std::string>{"a", "b", "c"});
+        Expect(cases.size()).ToEqual(std::size_t{6});
+        Expect(cases[0] == std::tuple<int, std::string>{1, "a"}).ToBeTrue();
+        Expect(cases[2] == std::tuple<int, std::string>{1, "c"}).ToBeTrue();
+        Expect(cases[3] == std::tuple<int, std::string>{2, "a"}).ToBeTrue();
+    }
+
+    void TestPairwiseCoversEveryPair() {
+        auto table = CombinationTable::Covering({3, 3, 3, 3}, 2);
+        Expect(table.size()).ToEqual(std::size_t{9});  // optimal for four ternary dimensions
+        auto coverage = table.Coverage(AllRows(table));
+        Expect(coverage.covered).ToEqual(std::size_t{54});
+        Expect(coverage.total).ToEqual(std::size_t{54});
+    }
+
+    void TestHigherStrengthAndDeterminism() {
+        auto table = CombinationTable::Covering({2, 3, 4, 2, 3}, 3);
+        Expect(table.size() < table.ProductSize()).ToBeTrue();
+        auto coverage = table.Coverage(AllRows(table));
+        Expect(coverage.covered).ToEqual(coverage.total);
+
+        auto again = CombinationTable::Covering({2, 3, 4, 2, 3}, 3);
+        Expect(again.size()).ToEqual(table.size());
+        for (std::size_t row = 0; row < table.size(); ++row) {
+            for (std::size_t d = 0; d < table.Dimensions(); ++d) {
+                Expect(again.Value(row, d)).ToEqual(table.Value(row, d));
+            }
+        }
+    }
+
+    void TestFullStrengthIsProduct() {
+        auto table = CombinationTable::Covering({2, 3}, 2);
+        Expect(table.size()).ToEqual(std::size_t{6});
+        Expect(table.Strength()).ToEqual(std::size_t{2});
+        Expect(table.Value(4, 1)).ToEqual(std::size_t{1});
+    }
+
+    void TestInvalidMatrices() {
+        ExpectCallable([] { CombinationTable::Covering({2, 2}, 0); })
+            .ToThrow<std::invalid_argument>();
+        ExpectCallable([] { CombinationTable::Product({2, 0, 2}); })
+            .ToThrow<std::invalid_argument>();
+        ExpectCallable([] { CombinationTable::Product({}); }).ToThrow<std::invalid_argument>();
+        ExpectCallable([] {
+            CombinationTable::Product({std::size_t{1} << 32U, std::size_t{1} << 32U});
+        }).ToThrow<std::invalid_argument>();
+    }
+
+    void TestCoveringLargerThanCountableProduct() {
+        auto table = CombinationTable::Covering(std::vector<std::size_t>(65, 2), 1);
+        Expect(table.CountProduct().has_value()).ToBeFalse();
+        ExpectCallable([&] { (void)table.ProductSize(); }).ToThrow<std::invalid_argument>();
+        auto coverage = table.Coverage(AllRows(table));
+        Expect(coverage.covered).ToEqual(coverage.total);
+    }
+
+    void TestCasesAreNamedEntries() {
+        Registry reg;
+        reg.AddParameterized(
+            "Config", "Record", &ConfigSuite::Record,
+            PairwiseCases(std::vector{1, 2, 3}, std::vector<std::string>{"x", "y"},
+                          std::vector{false, true}));
+        Expect(reg.Tests().size()).ToEqual(std::size_t{6});
+        Expect(reg.Tests()[5].test_name).ToEqual(std::string_view("Record/5"));
+        Expect(reg.Matrices().size()).ToEqual(std::size_t{1});
+
+        auto found = reg.FindMatrixRow(reg.Tests()[4]);
+        Expect(found.has_value()).ToBeTrue();
+        Expect(found->row).ToEqual(std::uint32_t{4});
+
+        g_configs.clear();
+        reg.Tests()[0].callable();
+        Expect(g_configs.size()).ToEqual(std::size_t{1});
+        Expect(std::get<0>(g_configs[0])).ToEqual(1);
+    }
+
+    void TestSummaryReportsCoverage() {
+        Registry reg;
+        reg.AddParameterized(
+            "Config", "Record", &ConfigSuite::Record,
+            ProductCases(std::vector{1, 2, 3}, std::vector<std::string>{"x", "y"},
+                         std::vector{false, true}));
+        reg.Filter("re:Record/(1|10)$");  // (1, "x", true) and (3, "y", false)
+        OutputCapture capture(4096);
+        Runner runner(reg);
+        Expect(runner.RunAll()).ToEqual(0);
+        auto text = capture.Finish();
+        Expect(text.contains("Config::Record: 2 of 12 combinations, 3-way coverage 2/12"))
+            .ToBeTrue();
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "MatrixSuite",
+                 {
+                     {"TestProductVariesLastDimensionFastest",
+                      &MatrixSuite::TestProductVariesLastDimensionFastest},
+                     {"TestPairwiseCoversEveryPair", &MatrixSuite::TestPairwiseCoversEveryPair},
+                     {"TestHigherStrengthAndDeterminism",
+                      &MatrixSuite::TestHigherStrengthAndDeterminism},
+                     {"TestFullStrengthIsProduct", &MatrixSuite::TestFullStrengthIsProduct},
+                     {"TestInvalidMatrices", &MatrixSuite::TestInvalidMatrices},
+                     {"TestCoveringLargerThanCountableProduct",
+                      &MatrixSuite::TestCoveringLargerThanCountableProduct},
+                     {"TestCasesAreNamedEntries", &MatrixSuite::TestCasesAreNamedEntries},
+                     {"TestSummaryReportsCoverage", &MatrixSuite::TestSummaryReportsCoverage},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace matrix_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    MatrixSuite::Register(r);
+}
+}  // namespace matrix_test
@@ -0,0 +1,74 @@
+#include "flul/test/memory_limit.hpp"
+
+#include <unistd.h>
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+#include "flul/test/subprocess.hpp"
+
+using flul::test::ChildOutcome;
+using flul::test::Expect;
+using flul::test::MemoryLimit;
+using flul::test::ReadProcStatus;
+using flul::test::ReadProcStatusField;
+using flul::test::Registry;
+using flul::test::RunInChild;
+using flul::test::Suite;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class MemoryLimitSuite : public Suite<MemoryLimitSuite> {
+   public:
+    void TestDisabledByDefault() {
+        MemoryLimit limit(0);
+        Expect(limit.Exceeded()).ToBeFalse();
+    }
+
+    void TestReadProcStatus() {
+#if defined(__linux__)
+        Expect(ReadProcStatus("VmRSS").value_or(0)).ToBeGreaterThan(std::size_t{0});
+        Expect(ReadProcStatusField("Threads").value_or(0)).ToBeGreaterThan(std::size_t{0});
+        Expect(ReadProcStatusField("Name").has_value()).ToBeFalse();  // not a number
+#endif
+        Expect(ReadProcStatus("NoSuchKey").has_value()).ToBeFalse();
+    }
+
+    void TestDetectsExhaustion() {
+#if defined(__linux__)
+        // Run in a child so a misbehaving limit can never affect the runner itself.
+        auto hog = [] {
+            MemoryLimit limit(std::size_t{64} << 20U);
+            try {
+                std::vector<char> block(std::size_t{1} << 30U);
+                ::_exit(2);
+            } catch (const std::bad_alloc&) {
+                ::_exit(limit.Exceeded() ? 0 : 1);
+            }
+        };
+        auto outcome = RunInChild(hog);
+        Expect(outcome.kind == ChildOutcome::Kind::kExited).ToBeTrue();
+        Expect(outcome.code).ToEqual(0);
+#endif
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "MemoryLimitSuite",
+                 {
+                     {"TestDisabledByDefault", &MemoryLimitSuite::TestDisabledByDefault},
+                     {"TestReadProcStatus", &MemoryLimitSuite::TestReadProcStatus},
+                     {"TestDetectsExhaustion", &MemoryLimitSuite::TestDetectsExhaustion},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace memory_limit_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    MemoryLimitSuite::Register(r);
+}
+}  // namespace memory_limit_test
@@ -0,0 +1,88 @@
+#include "flul/test/name_index.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::Expect;
+using flul::test::NameIndex;
+using flul::test::Registry;
+using flul::test::Suite;
+using flul::test::TestEntry;
+
+namespace {
+
+void Noop(const flul::test::TestCallable& /*self*/) {}
+
+auto Entry(std::string_view suite, std::string_view test) -> TestEntry {
+    return {.suite_name = suite, .test_name = test, .callable = {.invoke = &Noop}};
+}
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class NameIndexSuite : public Suite<NameIndexSuite> {
+   public:
+    void TestFindsExactNames() {
+        const std::vector<TestEntry> tests = {Entry("Math", "Test"), Entry("Math", "Test2"),
+                                              Entry("Io", "Read")};
+        NameIndex index(tests);
+        Expect(index.Find("Math::Test")).ToEqual(std::optional<std::uint32_t>(0));
+        Expect(index.Find("Math::Test2")).ToEqual(std::optional<std::uint32_t>(1));
+        Expect(index.Find("Io::Read")).ToEqual(std::optional<std::uint32_t>(2));
+    }
+
+    void TestRejectsPartialNames() {
+        const std::vector<TestEntry> tests = {Entry("Math", "Test2")};
+        NameIndex index(tests);
+        Expect(index.Find("Math::Test").has_value()).ToBeFalse();
+        Expect(index.Find("Math").has_value()).ToBeFalse();
+        Expect(index.Find("Math:Test2").has_value()).ToBeFalse();
+        Expect(index.Find("").has_value()).ToBeFalse();
+    }
+
+    void TestDuplicateFindsFirst() {
+        const std::vector<TestEntry> tests = {Entry("A", "B"), Entry("A", "B")};
+        NameIndex index(tests);
+        Expect(index.Find("A::B")).ToEqual(std::optional<std::uint32_t>(0));
+    }
+
+    void TestManyNames() {
+        std::deque<std::string> names;
+        std::vector<TestEntry> tests;
+        for (int i = 0; i < 20000; ++i) {
+            tests.push_back(Entry("Suite", names.emplace_back(std::format("Test{}", i))));
+        }
+        NameIndex index(tests);
+        for (std::uint32_t i = 0; i < tests.size(); i += 97) {
+            Expect(index.Find(std::format("Suite::Test{}", i)))
+                .ToEqual(std::optional<std::uint32_t>(i));
+        }
+        Expect(index.Find("Suite::Test20000").has_value()).ToBeFalse();
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "NameIndexSuite",
+                 {
+                     {"TestFindsExactNames", &NameIndexSuite::TestFindsExactNames},
+                     {"TestRejectsPartialNames", &NameIndexSuite::TestRejectsPartialNames},
+                     {"TestDuplicateFindsFirst", &NameIndexSuite::TestDuplicateFindsFirst},
+                     {"TestManyNames", &NameIndexSuite::TestManyNames},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace name_index_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    NameIndexSuite::Register(r);
+}
+}  // namespace name_index_test
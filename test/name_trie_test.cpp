@@ -0,0 +1,114 @@
+#include "flul/test/name_trie.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/output_capture.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::Expect;
+using flul::test::NameTrie;
+using flul::test::OutputCapture;
+using flul::test::Registry;
+using flul::test::Suite;
+
+namespace {
+
+struct Name {
+    std::string_view suite_name;
+    std::string_view test_name;
+};
+
+using Ids = std::vector<std::uint32_t>;
+
+auto Storage() -> std::vector<Name> {
+    return {{"Storage::Btree", "Insert::Concurrent"},
+            {"Storage::Log", "Append"},
+            {"Storage::Btree", "Insert::Sequential"},
+            {"Net", "Connect"},
+            {"Storage::Btree", "Erase"}};
+}
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class NameTrieSuite : public Suite<NameTrieSuite> {
+   public:
+    void TestCountsNestedGroups() {
+        auto names = Storage();
+        NameTrie trie(names);
+        Expect(trie.Nodes()[NameTrie::kRoot].count).ToEqual(std::size_t{5});
+        Expect(trie.Nodes()[*trie.Find("Storage")].count).ToEqual(std::size_t{4});
+        Expect(trie.Nodes()[*trie.Find("Storage::Btree")].count).ToEqual(std::size_t{3});
+        Expect(trie.Nodes()[*trie.Find("Storage::Btree::Insert")].count).ToEqual(std::size_t{2});
+    }
+
+    void TestFindWholeComponentsOnly() {
+        auto names = Storage();
+        NameTrie trie(names);
+        Expect(trie.Find("Storage::Bt").has_value()).ToBeFalse();
+        Expect(trie.Find("Stor").has_value()).ToBeFalse();
+        Expect(trie.Find("Net::Connect").has_value()).ToBeTrue();
+        Expect(*trie.Find("")).ToEqual(NameTrie::kRoot);
+    }
+
+    void TestSubtreeInRegistryOrder() {
+        auto names = Storage();
+        NameTrie trie(names);
+        Expect(trie.Subtree(*trie.Find("Storage::Btree")) == Ids{0, 2, 4}).ToBeTrue();
+        Expect(trie.Subtree(*trie.Find("Storage")) == Ids{0, 1, 2, 4}).ToBeTrue();
+        Expect(trie.Path(*trie.Find("Storage::Btree::Insert")))
+            .ToEqual(std::string("Storage::Btree::Insert"));
+    }
+
+    void TestRollupSumsSubtrees() {
+        using std::chrono::milliseconds;
+        auto names = Storage();
+        NameTrie trie(names);
+        const std::vector<milliseconds> times = {milliseconds(1), milliseconds(2),
+                                                 milliseconds(4), milliseconds(8),
+                                                 milliseconds(16)};
+        auto totals = trie.Rollup<milliseconds>(times);
+        Expect(totals[NameTrie::kRoot].count()).ToEqual(31);
+        Expect(totals[*trie.Find("Storage")].count()).ToEqual(23);
+        Expect(totals[*trie.Find("Storage::Btree::Insert")].count()).ToEqual(5);
+    }
+
+    void TestPrintShowsCounts() {
+        auto names = Storage();
+        NameTrie trie(names);
+        OutputCapture capture(4096);
+        trie.Print(stdout);
+        std::fflush(stdout);
+        auto text = capture.Finish();
+        Expect(text.starts_with("Storage (4)\n  Btree (3)\n    Insert (2)\n      Concurrent\n"))
+            .ToBeTrue();
+        Expect(text.contains("\n  Log (1)\n    Append\nNet (1)\n  Connect\n")).ToBeTrue();
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "NameTrieSuite",
+                 {
+                     {"TestCountsNestedGroups", &NameTrieSuite::TestCountsNestedGroups},
+                     {"TestFindWholeComponentsOnly", &NameTrieSuite::TestFindWholeComponentsOnly},
+                     {"TestSubtreeInRegistryOrder", &NameTrieSuite::TestSubtreeInRegistryOrder},
+                     {"TestRollupSumsSubtrees", &NameTrieSuite::TestRollupSumsSubtrees},
+                     {"TestPrintShowsCounts", &NameTrieSuite::TestPrintShowsCounts},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace name_trie_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    NameTrieSuite::Register(r);
+}
+}  // namespace name_trie_test
@@ -0,0 +1,123 @@
+#include "flul/test/output_capture.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <format>
+#include <print>
+#include <string>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::Expect;
+using flul::test::OutputCapture;
+using flul::test::Registry;
+using flul::test::Suite;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class OutputCaptureSuite : public Suite<OutputCaptureSuite> {
+   public:
+    void TestCapturesStdout() {
+        OutputCapture capture(1024);
+        std::println("hello from stdout");
+        auto text = capture.Finish();
+        Expect(text).ToEqual(std::string("hello from stdout\n"));
+    }
+
+    void TestCapturesStderr() {
+        OutputCapture capture(1024);
+        std::println(stderr, "hello from stderr");
+        auto text = capture.Finish();
+        Expect(text.contains("hello from stderr")).ToBeTrue();
+    }
+
+    void TestTruncatesAtLimit() {
+        OutputCapture capture(4);
+        std::print("0123456789");
+        auto text = capture.Finish();
+        Expect(text.starts_with("0123")).ToBeTrue();
+        Expect(text.contains("6 bytes truncated")).ToBeTrue();
+    }
+
+    void TestBoundsOutputWhileTheTestWrites() {
+        constexpr std::size_t kWritten = 1 << 20;  // many times the pipe buffer
+        OutputCapture capture(100);
+        std::string line(1023, 'x');
+        for (std::size_t i = 0; i < kWritten / 1024; ++i) {
+            std::println("{}", line);
+        }
+        auto text = capture.Finish();
+        Expect(text.starts_with(std::string(100, 'x'))).ToBeTrue();
+        Expect(text.substr(100)).ToEqual(
+            std::format("\n[... {} bytes truncated]\n", kWritten - 100));
+    }
+
+    void TestNested() {
+        OutputCapture outer(1024);
+        std::print("outer ");
+        {
+            OutputCapture inner(1024);
+            std::print("inner");
+            Expect(inner.Finish()).ToEqual(std::string("inner"));
+        }
+        std::print("again");
+        Expect(outer.Finish()).ToEqual(std::string("outer again"));
+    }
+
+    void TestReusedAcrossStarts() {
+        OutputCapture capture(1024, false);
+        Expect(capture.Finish()).ToEqual(std::string());
+        for (const auto* word : {"first", "second"}) {
+            capture.Start();
+            std::print("{}", word);
+            Expect(capture.Finish()).ToEqual(std::string(word));
+        }
+    }
+
+    void TestChildHoldingDescriptorsDoesNotBlock() {
+        OutputCapture capture(1024);
+        std::print("parent");
+        std::fflush(stdout);
+        auto child = ::fork();
+        if (child == 0) {
+            ::sleep(2);  // keeps the redirected stdout and stderr open past Finish()
+            ::_exit(0);
+        }
+        auto start = std::chrono::steady_clock::now();
+        auto text = capture.Finish();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        ::kill(child, SIGKILL);
+        ::waitpid(child, nullptr, 0);
+        Expect(text).ToEqual(std::string("parent"));
+        Expect(elapsed < std::chrono::seconds(1)).ToBeTrue();
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "OutputCaptureSuite",
+                 {
+                     {"TestCapturesStdout", &OutputCaptureSuite::TestCapturesStdout},
+                     {"TestCapturesStderr", &OutputCaptureSuite::TestCapturesStderr},
+                     {"TestTruncatesAtLimit", &OutputCaptureSuite::TestTruncatesAtLimit},
+                     {"TestBoundsOutputWhileTheTestWrites",
+                      &OutputCaptureSuite::TestBoundsOutputWhileTheTestWrites},
+                     {"TestNested", &OutputCaptureSuite::TestNested},
+                     {"TestReusedAcrossStarts", &OutputCaptureSuite::TestReusedAcrossStarts},
+                     {"TestChildHoldingDescriptorsDoesNotBlock",
+                      &OutputCaptureSuite::TestChildHoldingDescriptorsDoesNotBlock},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace output_capture_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    OutputCaptureSuite::Register(r);
+}
+}  // namespace output_capture_test
@@ -0,0 +1,133 @@
+#include "flul/test/property.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flul/test/assertion_error.hpp"
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::AssertionError;
+using flul::test::CheckProperty;
+using flul::test::Expect;
+using flul::test::Integers;
+using flul::test::PropertyOptions;
+using flul::test::Registry;
+using flul::test::SplitMix64;
+using flul::test::Strings;
+using flul::test::Suite;
+using flul::test::VectorsOf;
+
+namespace {
+
+// The AssertionError CheckProperty reports for a property expected to fail.
+template <typename G, typename F>
+auto Counterexample(const G& generate, const F& property, PropertyOptions options,
+                    std::source_location loc = std::source_location::current())
+    -> AssertionError {
+    try {
+        CheckProperty(generate, property, options);
+    } catch (const AssertionError& e) {
+        return e;
+    }
+    throw AssertionError("property held", "a counterexample", loc);
+}
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class PropertySuite : public Suite<PropertySuite> {
+   public:
+    void TestSplitMix64ReferenceOutput() {
+        SplitMix64 rng(0);
+        Expect(rng.Next()).ToEqual(std::uint64_t{0xe220a8397b1dcdaf});
+        Expect(rng.Next()).ToEqual(std::uint64_t{0x6e789e6aa1b965f4});
+    }
+
+    void TestHoldingPropertyPasses() {
+        CheckProperty(Integers<int>(-3, 3), [](int x) { return x >= -3 && x <= 3; },
+                      {.cases = 5000});
+    }
+
+    void TestShrinksIntegerToBoundary() {
+        auto error = Counterexample(Integers<int>(), [](int x) { return x < 1000; }, {.seed = 1});
+        Expect(error.actual).ToEqual(std::string("1000"));
+        Expect(error.expected.contains("seed 0x1")).ToBeTrue();
+    }
+
+    void TestShrinksExpectFailure() {
+        auto error = Counterexample(
+            Integers<int>(-500, 500), [](int x) { Expect(x).ToBeGreaterThan(-17); }, {.seed = 7});
+        Expect(error.actual).ToEqual(std::string("-17"));
+    }
+
+    void TestShrinksVectorToOneElement() {
+        auto error = Counterexample(
+            VectorsOf(Integers<int>(0, 100)),
+            [](const std::vector<int>& values) {
+                return std::ranges::find(values, 42) == values.end();
+            },
+            {.seed = 3});
+        Expect(error.actual).ToEqual(std::string("[42]"));
+    }
+
+    void TestShrinksString() {
+        auto error = Counterexample(
+            Strings(), [](const std::string& text) { return !text.contains('z'); }, {.seed = 5});
+        Expect(error.actual).ToEqual(std::string("z"));
+    }
+
+    void TestSeedReproducesAcrossThreadCounts() {
+        auto property = [](int x) { return x % 97 != 13; };
+        auto serial = Counterexample(Integers<int>(), property, {.seed = 11, .threads = 1});
+        auto parallel = Counterexample(Integers<int>(), property, {.seed = 11, .threads = 8});
+        Expect(parallel.expected).ToEqual(serial.expected);
+        Expect(parallel.actual).ToEqual(serial.actual);
+    }
+
+    void TestRunsOnCallingThreadByDefault() {
+        auto caller = std::this_thread::get_id();
+        std::size_t elsewhere = 0;
+        std::size_t calls = 0;
+        CheckProperty(Integers<int>(), [&](int) {
+            ++calls;
+            if (std::this_thread::get_id() != caller) {
+                ++elsewhere;
+            }
+        });
+        Expect(calls).ToEqual(PropertyOptions{}.cases);
+        Expect(elsewhere).ToEqual(std::size_t{0});
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "PropertySuite",
+                 {
+                     {"TestSplitMix64ReferenceOutput",
+                      &PropertySuite::TestSplitMix64ReferenceOutput},
+                     {"TestHoldingPropertyPasses", &PropertySuite::TestHoldingPropertyPasses},
+                     {"TestShrinksIntegerToBoundary", &PropertySuite::TestShrinksIntegerToBoundary},
+                     {"TestShrinksExpectFailure", &PropertySuite::TestShrinksExpectFailure},
+                     {"TestShrinksVectorToOneElement",
+                      &PropertySuite::TestShrinksVectorToOneElement},
+                     {"TestShrinksString", &PropertySuite::TestShrinksString},
+                     {"TestSeedReproducesAcrossThreadCounts",
+                      &PropertySuite::TestSeedReproducesAcrossThreadCounts},
+                     {"TestRunsOnCallingThreadByDefault",
+                      &PropertySuite::TestRunsOnCallingThreadByDefault},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace property_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    PropertySuite::Register(r);
+}
+}  // namespace property_test
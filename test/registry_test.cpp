@@ -1,6 +1,10 @@
 #include "flul/test/registry.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
+#include <string_view>
 
 #include "flul/test/expect.hpp"
 #include "flul/test/expect_callable.hpp"
@@ -42,6 +46,15 @@ bool TearDownSuite::g_tear_down_called = false;
 
 // NOLINTEND(readability-convert-member-functions-to-static)
 
+void AddAlpha(Registry& r) {
+    r.Add<DummySuite>("Alpha", "Pass", &DummySuite::Pass);
+}
+
+void AddBeta(Registry& r) {
+    r.Add<DummySuite>("Beta", "Pass", &DummySuite::Pass);
+    r.Depend("Beta::Pass", "Alpha::Pass");
+}
+
 }  // namespace
 
 // NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
@@ -56,6 +69,19 @@ class RegistrySuite : public Suite<RegistrySuite> {
         Expect(reg.Tests()[0].test_name).ToEqual(std::string_view("Pass"));
     }
 
+    void TestCopyKeepsCallables() {
+        Registry copy;
+        {
+            Registry reg;
+            reg.Add<TearDownSuite>("TearDown", "ThrowAfterSetUp",
+                                   &TearDownSuite::ThrowAfterSetUp);
+            copy = reg;
+        }
+        TearDownSuite::g_tear_down_called = false;
+        ExpectCallable([&copy] { copy.Tests()[0].callable(); }).ToThrow<std::runtime_error>();
+        Expect(TearDownSuite::g_tear_down_called).ToBeTrue();
+    }
+
     void TestFilter() {
         Registry reg;
         reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
@@ -65,6 +91,94 @@ class RegistrySuite : public Suite<RegistrySuite> {
         Expect(reg.Tests()[0].test_name).ToEqual(std::string_view("Pass"));
     }
 
+    void TestFilterKeepsPrerequisites() {
+        Registry reg;
+        reg.Add<DummySuite>("Build", "Artifact", &DummySuite::Pass);
+        reg.Add<DummySuite>("Dummy", "Throw", &DummySuite::Throw);
+        reg.Add<DummySuite>("Read", "Artifact", &DummySuite::Pass);
+        reg.Depend("Read::Artifact", "Build::Artifact");
+        reg.Filter("Read::");
+        Expect(reg.Tests().size()).ToEqual(std::size_t{2});
+        Expect(reg.Tests()[0].suite_name).ToEqual(std::string_view("Build"));
+        Expect(reg.Prerequisites()[1].size()).ToEqual(std::size_t{1});
+        Expect(reg.Prerequisites()[1][0]).ToEqual(std::uint32_t{0});
+    }
+
+    void TestSelectExactNames() {
+        Registry reg;
+        reg.Add<DummySuite>("Build", "Artifact", &DummySuite::Pass);
+        reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+        reg.Add<DummySuite>("Dummy", "Pass2", &DummySuite::Pass);
+        reg.Add<DummySuite>("Read", "Artifact", &DummySuite::Pass);
+        reg.Depend("Read::Artifact", "Build::Artifact");
+        const std::array<std::string_view, 3> names = {"Read::Artifact", "Dummy::Pass",
+                                                       "Dummy::Missing"};
+        auto unknown = reg.Select(names);
+        Expect(unknown.size()).ToEqual(std::size_t{1});
+        Expect(unknown[0]).ToEqual(std::string_view("Dummy::Missing"));
+        Expect(reg.Tests().size()).ToEqual(std::size_t{3});
+        Expect(reg.Tests()[0].suite_name).ToEqual(std::string_view("Build"));
+        Expect(reg.Tests()[1].test_name).ToEqual(std::string_view("Pass"));
+        Expect(reg.Prerequisites()[2][0]).ToEqual(std::uint32_t{0});
+    }
+
+    void TestSelectPrefix() {
+        Registry reg;
+        reg.Add<DummySuite>("Storage::Btree", "Insert", &DummySuite::Pass);
+        reg.Add<DummySuite>("Storage::BtreeExtra", "Insert", &DummySuite::Pass);
+        reg.Add<DummySuite>("Storage::Btree", "Erase", &DummySuite::Pass);
+        Expect(reg.SelectPrefix("Storage::Bt")).ToBeFalse();
+        Expect(reg.Tests().size()).ToEqual(std::size_t{3});
+        Expect(reg.SelectPrefix("Storage::Btree")).ToBeTrue();
+        Expect(reg.Tests().size()).ToEqual(std::size_t{2});
+        Expect(reg.Tests()[1].test_name).ToEqual(std::string_view("Erase"));
+    }
+
+    void TestDeferExpandsOnDemand() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+        reg.Defer("Alpha", &AddAlpha);
+        Expect(reg.Tests().size()).ToEqual(std::size_t{1});
+        reg.Expand([](std::string_view suite) { return suite == "Other"; });
+        Expect(reg.Tests().size()).ToEqual(std::size_t{1});
+        reg.ExpandAll();
+        reg.ExpandAll();
+        Expect(reg.Tests().size()).ToEqual(std::size_t{2});
+        Expect(reg.Tests()[1].suite_name).ToEqual(std::string_view("Alpha"));
+    }
+
+    void TestDependExpandsDeferredSuite() {
+        Registry reg;
+        reg.Defer("Alpha", &AddAlpha);
+        reg.Defer("Beta", &AddBeta);
+        reg.Expand([](std::string_view suite) { return suite == "Beta"; });
+        Expect(reg.Tests().size()).ToEqual(std::size_t{2});
+        Expect(reg.Tests()[0].suite_name).ToEqual(std::string_view("Beta"));
+        Expect(reg.Tests()[1].suite_name).ToEqual(std::string_view("Alpha"));
+        Expect(reg.Prerequisites()[0][0]).ToEqual(std::uint32_t{1});
+    }
+
+    void TestDependRejectsCycle() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "A", &DummySuite::Pass);
+        reg.Add<DummySuite>("Dummy", "B", &DummySuite::Pass);
+        reg.Add<DummySuite>("Dummy", "C", &DummySuite::Pass);
+        reg.Depend("Dummy::B", "Dummy::A");
+        reg.Depend("Dummy::C", "Dummy::B");
+        ExpectCallable([&reg] { reg.Depend("Dummy::A", "Dummy::C"); })
+            .ToThrow<std::invalid_argument>();
+        ExpectCallable([&reg] { reg.Depend("Dummy::A", "Dummy::A"); })
+            .ToThrow<std::invalid_argument>();
+        Expect(reg.Prerequisites()[0].empty()).ToBeTrue();
+    }
+
+    void TestDependRejectsUnknownTest() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "A", &DummySuite::Pass);
+        ExpectCallable([&reg] { reg.Depend("Dummy::A", "Dummy::Missing"); })
+            .ToThrow<std::invalid_argument>();
+    }
+
     void TestList() {
         Registry reg;
         reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
@@ -85,7 +199,16 @@ class RegistrySuite : public Suite<RegistrySuite> {
         AddTests(r, "RegistrySuite",
                  {
                      {"TestAddAndTests", &RegistrySuite::TestAddAndTests},
+                     {"TestCopyKeepsCallables", &RegistrySuite::TestCopyKeepsCallables},
                      {"TestFilter", &RegistrySuite::TestFilter},
+                     {"TestFilterKeepsPrerequisites", &RegistrySuite::TestFilterKeepsPrerequisites},
+                     {"TestSelectExactNames", &RegistrySuite::TestSelectExactNames},
+                     {"TestSelectPrefix", &RegistrySuite::TestSelectPrefix},
+                     {"TestDeferExpandsOnDemand", &RegistrySuite::TestDeferExpandsOnDemand},
+                     {"TestDependExpandsDeferredSuite",
+                      &RegistrySuite::TestDependExpandsDeferredSuite},
+                     {"TestDependRejectsCycle", &RegistrySuite::TestDependRejectsCycle},
+                     {"TestDependRejectsUnknownTest", &RegistrySuite::TestDependRejectsUnknownTest},
                      {"TestList", &RegistrySuite::TestList},
                      {"TestTearDownOnException", &RegistrySuite::TestTearDownOnException},
                  });
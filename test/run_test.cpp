@@ -1,5 +1,12 @@
 #include "flul/test/run.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
 #include "flul/test/expect.hpp"
 #include "flul/test/registry.hpp"
 
@@ -14,6 +21,19 @@ class DummySuite : public Suite<DummySuite> {
     void Pass() {}
 };
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+int g_expanded = 0;
+
+void AddDummy(Registry& r) {
+    ++g_expanded;
+    r.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+}
+
+void AddOther(Registry& r) {
+    ++g_expanded;
+    r.Add<DummySuite>("Other::Nested", "Pass", &DummySuite::Pass);
+}
+
 auto MakeArgv(std::initializer_list<const char*> args) -> std::vector<char*> {
     std::vector<char*> argv;
     for (const auto* a : args) {
@@ -48,6 +68,203 @@ class RunSuite : public Suite<RunSuite> {
         Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(1);
     }
 
+    void TestFilterAndExclude() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+        reg.Add<DummySuite>("Dummy", "Slow", &DummySuite::Pass);
+        reg.Add<DummySuite>("Other", "Pass", &DummySuite::Pass);
+        auto argv = MakeArgv({"prog", "--filter", "Dummy::*", "--exclude", "re:Slow$", "--list"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(0);
+        Expect(reg.Tests().size()).ToEqual(std::size_t{1});
+        Expect(reg.Tests()[0].test_name).ToEqual(std::string_view("Pass"));
+    }
+
+    void TestFilterInvalidPattern() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+        auto argv = MakeArgv({"prog", "--filter", "re:(Dummy"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(1);
+    }
+
+    void TestExactSkipsPrefixMatches() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+        reg.Add<DummySuite>("Dummy", "Pass2", &DummySuite::Pass);
+        auto argv = MakeArgv({"prog", "--exact", "Dummy::Pass", "--list"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(0);
+        Expect(reg.Tests().size()).ToEqual(std::size_t{1});
+        Expect(reg.Tests()[0].test_name).ToEqual(std::string_view("Pass"));
+    }
+
+    void TestExactUnknownTest() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+        auto argv = MakeArgv({"prog", "--exact", "Dummy::Missing"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(1);
+    }
+
+    void TestTestsFrom() {
+        auto path = std::filesystem::temp_directory_path() / "flul_tests_from.txt";
+        {
+            std::ofstream list(path);
+            list << "# selected tests\n  Dummy::B  \r\n\nDummy::C\n";
+        }
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "A", &DummySuite::Pass);
+        reg.Add<DummySuite>("Dummy", "B", &DummySuite::Pass);
+        reg.Add<DummySuite>("Dummy", "C", &DummySuite::Pass);
+        auto file = path.string();
+        auto argv = MakeArgv({"prog", "--tests-from", file.c_str(), "--list"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(0);
+        std::filesystem::remove(path);
+        Expect(reg.Tests().size()).ToEqual(std::size_t{2});
+        Expect(reg.Tests()[0].test_name).ToEqual(std::string_view("B"));
+
+        auto missing = MakeArgv({"prog", "--tests-from", "/nonexistent/flul_tests.txt"});
+        Expect(flul::test::Run(static_cast<int>(missing.size()), missing.data(), reg)).ToEqual(1);
+    }
+
+    void TestPrefixAndListTree() {
+        Registry reg;
+        reg.Add<DummySuite>("Net::Http", "Get", &DummySuite::Pass);
+        reg.Add<DummySuite>("Net::Tcp", "Connect", &DummySuite::Pass);
+        reg.Add<DummySuite>("Storage", "Read", &DummySuite::Pass);
+        auto argv = MakeArgv({"prog", "--prefix", "Net", "--list-tree"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(0);
+        Expect(reg.Tests().size()).ToEqual(std::size_t{2});
+
+        auto unknown = MakeArgv({"prog", "--prefix", "Ne"});
+        Expect(flul::test::Run(static_cast<int>(unknown.size()), unknown.data(), reg)).ToEqual(1);
+    }
+
+    void TestDeferredExpandsSelectedSuites() {
+        auto run = [](std::initializer_list<const char*> args) {
+            Registry reg;
+            reg.Defer("Dummy", &AddDummy);
+            reg.Defer("Other::Nested", &AddOther);
+            g_expanded = 0;
+            auto argv = MakeArgv(args);
+            Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(0);
+            return g_expanded;
+        };
+        Expect(run({"prog", "--exact", "Other::Nested::Pass", "--list"})).ToEqual(1);
+        Expect(run({"prog", "--prefix", "Other", "--list"})).ToEqual(1);
+        Expect(run({"prog", "--filter", "re:^Dummy::", "--list"})).ToEqual(1);
+        Expect(run({"prog", "--filter", "Pass", "--list"})).ToEqual(2);
+        Expect(run({"prog", "--list"})).ToEqual(2);
+    }
+
+    void TestNoCapture() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+        auto argv = MakeArgv({"prog", "--no-capture"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(0);
+    }
+
+    void TestOutputLimitMissingArg() {
+        Registry reg;
+        auto argv = MakeArgv({"prog", "--output-limit"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(1);
+    }
+
+    void TestWorkers() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+        auto argv = MakeArgv({"prog", "--workers", "2"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(0);
+    }
+
+    void TestWorkersAuto() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+        auto argv = MakeArgv({"prog", "--workers", "auto"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(0);
+    }
+
+    void TestWorkersInvalid() {
+        Registry reg;
+        auto argv = MakeArgv({"prog", "--workers", "many"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(1);
+    }
+
+    void TestTagsOption() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "A", &DummySuite::Pass, {"slow"});
+        reg.Add<DummySuite>("Dummy", "B", &DummySuite::Pass, {"fast"});
+        auto argv = MakeArgv({"prog", "--tags", "not fast", "--list", "--with-tags"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(0);
+        Expect(reg.Tests().size()).ToEqual(std::size_t{1});
+        Expect(reg.Tests()[0].test_name).ToEqual(std::string_view("A"));
+
+        auto invalid = MakeArgv({"prog", "--tags", "slow and"});
+        Expect(flul::test::Run(static_cast<int>(invalid.size()), invalid.data(), reg)).ToEqual(1);
+    }
+
+    void TestFuzzOptions() {
+        Registry reg;
+        auto unknown = MakeArgv({"prog", "--fuzz", "Dummy::Parse"});
+        Expect(flul::test::Run(static_cast<int>(unknown.size()), unknown.data(), reg)).ToEqual(1);
+        auto no_runs = MakeArgv({"prog", "--fuzz", "Dummy::Parse", "--fuzz-runs", "x"});
+        Expect(flul::test::Run(static_cast<int>(no_runs.size()), no_runs.data(), reg)).ToEqual(1);
+        auto no_time = MakeArgv({"prog", "--fuzz-time", "0s"});
+        Expect(flul::test::Run(static_cast<int>(no_time.size()), no_time.data(), reg)).ToEqual(1);
+        auto no_seed = MakeArgv({"prog", "--fuzz", "Dummy::Parse", "--fuzz-seed", "0xzz"});
+        Expect(flul::test::Run(static_cast<int>(no_seed.size()), no_seed.data(), reg)).ToEqual(1);
+    }
+
+    void TestMaxMemoryRequiresWorkers() {
+        Registry reg;
+        auto argv = MakeArgv({"prog", "--max-memory-per-test", "64M"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(1);
+    }
+
+    void TestParseBytes() {
+        Expect(flul::test::ParseBytes("512").value_or(0)).ToEqual(std::size_t{512});
+        Expect(flul::test::ParseBytes("64K").value_or(0)).ToEqual(std::size_t{64} << 10U);
+        Expect(flul::test::ParseBytes("2G").value_or(0)).ToEqual(std::size_t{2} << 30U);
+        Expect(flul::test::ParseBytes("lots").has_value()).ToBeFalse();
+        Expect(flul::test::ParseBytes("17179869184G").has_value()).ToBeFalse();
+        Expect(flul::test::ParseBytes("18446744073709551615").has_value()).ToBeTrue();
+    }
+
+    void TestParseSeed() {
+        Expect(flul::test::ParseSeed("42").value_or(0)).ToEqual(std::uint64_t{42});
+        Expect(flul::test::ParseSeed("0xff").value_or(0)).ToEqual(std::uint64_t{255});
+        Expect(flul::test::ParseSeed("0x").has_value()).ToBeFalse();
+        Expect(flul::test::ParseSeed("-1").has_value()).ToBeFalse();
+    }
+
+    void TestSoakInvalidDuration() {
+        Registry reg;
+        auto argv = MakeArgv({"prog", "--soak", "forever"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(1);
+    }
+
+    void TestSoakRejectsWorkers() {
+        Registry reg;
+        auto argv = MakeArgv({"prog", "--soak", "1s", "--workers", "2"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(1);
+    }
+
+    void TestParseDuration() {
+        using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace)
+        using flul::test::ParseDuration;
+        Expect(ParseDuration("500ms").value_or(0ns)).ToEqual(std::chrono::nanoseconds(500ms));
+        Expect(ParseDuration("30").value_or(0ns)).ToEqual(std::chrono::nanoseconds(30s));
+        Expect(ParseDuration("15m").value_or(0ns)).ToEqual(std::chrono::nanoseconds(15min));
+        Expect(ParseDuration("2h").value_or(0ns)).ToEqual(std::chrono::nanoseconds(2h));
+        Expect(ParseDuration("2d").has_value()).ToBeFalse();
+        Expect(ParseDuration("2562048h").has_value()).ToBeFalse();
+        Expect(ParseDuration("2562047h").has_value()).ToBeTrue();
+    }
+
+    void TestBisectUnknownTest() {
+        Registry reg;
+        reg.Add<DummySuite>("Dummy", "Pass", &DummySuite::Pass);
+        auto argv = MakeArgv({"prog", "--bisect-polluter", "Dummy::Missing"});
+        Expect(flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg)).ToEqual(1);
+    }
+
     void TestHelp() {
         Registry reg;
         auto argv = MakeArgv({"prog", "--help"});
@@ -66,6 +283,28 @@ class RunSuite : public Suite<RunSuite> {
                      {"TestList", &RunSuite::TestList},
                      {"TestFilterWorks", &RunSuite::TestFilterWorks},
                      {"TestFilterMissingArg", &RunSuite::TestFilterMissingArg},
+                     {"TestFilterAndExclude", &RunSuite::TestFilterAndExclude},
+                     {"TestFilterInvalidPattern", &RunSuite::TestFilterInvalidPattern},
+                     {"TestExactSkipsPrefixMatches", &RunSuite::TestExactSkipsPrefixMatches},
+                     {"TestExactUnknownTest", &RunSuite::TestExactUnknownTest},
+                     {"TestTestsFrom", &RunSuite::TestTestsFrom},
+                     {"TestPrefixAndListTree", &RunSuite::TestPrefixAndListTree},
+                     {"TestDeferredExpandsSelectedSuites",
+                      &RunSuite::TestDeferredExpandsSelectedSuites},
+                     {"TestNoCapture", &RunSuite::TestNoCapture},
+                     {"TestOutputLimitMissingArg", &RunSuite::TestOutputLimitMissingArg},
+                     {"TestWorkers", &RunSuite::TestWorkers},
+                     {"TestWorkersAuto", &RunSuite::TestWorkersAuto},
+                     {"TestWorkersInvalid", &RunSuite::TestWorkersInvalid},
+                     {"TestTagsOption", &RunSuite::TestTagsOption},
+                     {"TestFuzzOptions", &RunSuite::TestFuzzOptions},
+                     {"TestMaxMemoryRequiresWorkers", &RunSuite::TestMaxMemoryRequiresWorkers},
+                     {"TestParseBytes", &RunSuite::TestParseBytes},
+                     {"TestParseSeed", &RunSuite::TestParseSeed},
+                     {"TestSoakInvalidDuration", &RunSuite::TestSoakInvalidDuration},
+                     {"TestSoakRejectsWorkers", &RunSuite::TestSoakRejectsWorkers},
+                     {"TestParseDuration", &RunSuite::TestParseDuration},
+                     {"TestBisectUnknownTest", &RunSuite::TestBisectUnknownTest},
                      {"TestHelp", &RunSuite::TestHelp},
                      {"TestUnknownOption", &RunSuite::TestUnknownOption},
                  });
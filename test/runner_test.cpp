@@ -1,17 +1,58 @@
 #include "flul/test/runner.hpp"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <print>
 #include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "flul/test/expect.hpp"
+#include "flul/test/output_capture.hpp"
+#include "flul/test/process_pool.hpp"
 #include "flul/test/registry.hpp"
+#include "flul/test/test_entry.hpp"
+#include "flul/test/test_result.hpp"
 
 using flul::test::Expect;
+using flul::test::OutputCapture;
+using flul::test::ProcessPool;
 using flul::test::Registry;
 using flul::test::Runner;
+using flul::test::RunnerOptions;
 using flul::test::Suite;
+using flul::test::TestEntry;
+using flul::test::TestResult;
 
 namespace {
 
+// Bytes of memory held by the process pool's per-worker result files.
+auto ResultTextBytes() -> std::size_t {
+    std::size_t bytes = 0;
+    for (const auto& fd : std::filesystem::directory_iterator("/proc/self/fd")) {
+        std::error_code error;
+        auto target = std::filesystem::read_symlink(fd.path(), error);
+        struct stat info {};
+        if (!error && target.string().starts_with("/memfd:flul-results") &&
+            ::stat(fd.path().c_str(), &info) == 0) {
+            bytes += static_cast<std::size_t>(info.st_blocks) * 512;
+        }
+    }
+    return bytes;
+}
+
 // NOLINTBEGIN(readability-convert-member-functions-to-static)
 
 class PassingSuite : public Suite<PassingSuite> {
@@ -40,6 +81,52 @@ class UnknownExceptionSuite : public Suite<UnknownExceptionSuite> {
     }
 };
 
+class ChattySuite : public Suite<ChattySuite> {
+   public:
+    void PrintAndPass() {
+        std::println("chatty pass");
+    }
+
+    void PrintAndFail() {
+        std::println("chatty fail");
+        Expect(1).ToEqual(2);
+    }
+
+    void PrintLongAndFail() {
+        std::println("{}", std::string(20000, 'x'));
+        std::println("end of long output");
+        Expect(1).ToEqual(2);
+    }
+};
+
+class CrashingSuite : public Suite<CrashingSuite> {
+   public:
+    void Abort() {
+        std::abort();
+    }
+};
+
+class HogSuite : public Suite<HogSuite> {
+   public:
+    void AllocateGigabyte() {
+        std::vector<char> block(std::size_t{1} << 30U);
+        Expect(block.size()).ToBeGreaterThan(std::size_t{0});
+    }
+};
+
+class LeakySuite : public Suite<LeakySuite> {
+   public:
+    // Descriptors opened by LeakDescriptor; the soak test closes them afterwards.
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    static inline std::vector<int> leaked;
+
+    void LeakDescriptor() {
+        leaked.push_back(::open("/dev/null", O_RDONLY | O_CLOEXEC));
+        // Bound the number of iterations a short soak can fit in.
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+};
+
 // NOLINTEND(readability-convert-member-functions-to-static)
 
 }  // namespace
@@ -77,6 +164,273 @@ class RunnerSuite : public Suite<RunnerSuite> {
         Expect(runner.RunAll()).ToEqual(1);
     }
 
+    void TestReplaysOutputOnFailure() {
+        Registry reg;
+        reg.Add<ChattySuite>("Chatty", "PrintAndFail", &ChattySuite::PrintAndFail);
+        OutputCapture capture(4096);
+        Runner runner(reg);
+        runner.RunAll();
+        auto text = capture.Finish();
+        Expect(text.contains("chatty fail")).ToBeTrue();
+    }
+
+    void TestHidesOutputOnPass() {
+        Registry reg;
+        reg.Add<ChattySuite>("Chatty", "PrintAndPass", &ChattySuite::PrintAndPass);
+        OutputCapture capture(4096);
+        Runner runner(reg);
+        runner.RunAll();
+        auto text = capture.Finish();
+        Expect(text.contains("chatty pass")).ToBeFalse();
+    }
+
+    void TestShowOutput() {
+        Registry reg;
+        reg.Add<ChattySuite>("Chatty", "PrintAndPass", &ChattySuite::PrintAndPass);
+        OutputCapture capture(4096);
+        Runner runner(reg, RunnerOptions{.show_output = true});
+        runner.RunAll();
+        auto text = capture.Finish();
+        Expect(text.contains("chatty pass")).ToBeTrue();
+    }
+
+    void TestGroupTiming() {
+        Registry reg;
+        reg.Add<PassingSuite>("Storage::Btree", "Insert", &PassingSuite::Pass);
+        reg.Add<PassingSuite>("Storage::Btree", "Erase", &PassingSuite::Pass);
+        reg.Add<PassingSuite>("Storage::Log", "Append", &PassingSuite::Pass);
+        OutputCapture capture(4096);
+        Runner runner(reg, RunnerOptions{.group_timing = true});
+        Expect(runner.RunAll()).ToEqual(0);
+        auto text = capture.Finish();
+        auto summary = text.find("Slowest groups:");
+        Expect(summary != std::string::npos).ToBeTrue();
+        auto groups = text.substr(summary);
+        Expect(groups.contains("Storage (3 tests)")).ToBeTrue();
+        Expect(groups.contains("Storage::Btree (2 tests)")).ToBeTrue();
+        Expect(groups.contains("Storage::Btree::Insert")).ToBeFalse();
+    }
+
+    void TestWorkersPass() {
+        Registry reg;
+        reg.Add<PassingSuite>("Passing", "Pass1", &PassingSuite::Pass);
+        reg.Add<PassingSuite>("Passing", "Pass2", &PassingSuite::Pass);
+        reg.Add<PassingSuite>("Passing", "Pass3", &PassingSuite::Pass);
+        Runner runner(reg, RunnerOptions{.workers = 2});
+        Expect(runner.RunAll()).ToEqual(0);
+    }
+
+    void TestDependenciesInProcess() {
+        Registry reg;
+        reg.Add<PassingSuite>("Dag", "Reader", &PassingSuite::Pass);
+        reg.Add<PassingSuite>("Dag", "Builder", &PassingSuite::Pass);
+        reg.Add<FailingSuite>("Dag", "Broken", &FailingSuite::FailAssert);
+        reg.Add<PassingSuite>("Dag", "NeedsBroken", &PassingSuite::Pass);
+        reg.Add<PassingSuite>("Dag", "Transitive", &PassingSuite::Pass);
+        reg.Depend("Dag::Reader", "Dag::Builder");
+        reg.Depend("Dag::NeedsBroken", "Dag::Broken");
+        reg.Depend("Dag::Transitive", "Dag::NeedsBroken");
+        OutputCapture capture(4096);
+        Runner runner(reg);
+        Expect(runner.RunAll()).ToEqual(1);
+        auto text = capture.Finish();
+        Expect(text.find("Dag::Builder")).ToBeLessThan(text.find("Dag::Reader"));
+        Expect(text.contains("[ PASS ] Dag::Reader")).ToBeTrue();
+        Expect(text.contains("[ SKIP ] Dag::NeedsBroken (prerequisite Dag::Broken did not pass)"))
+            .ToBeTrue();
+        Expect(text.contains("[ SKIP ] Dag::Transitive")).ToBeTrue();
+        Expect(text.contains("5 tests, 2 passed, 1 failed, 2 skipped")).ToBeTrue();
+    }
+
+    void TestDependenciesWorkers() {
+        Registry reg;
+        reg.Add<PassingSuite>("Dag", "Reader", &PassingSuite::Pass);
+        reg.Add<PassingSuite>("Dag", "Builder", &PassingSuite::Pass);
+        reg.Add<CrashingSuite>("Dag", "Crash", &CrashingSuite::Abort);
+        reg.Add<PassingSuite>("Dag", "NeedsCrash", &PassingSuite::Pass);
+        reg.Depend("Dag::Reader", "Dag::Builder");
+        reg.Depend("Dag::NeedsCrash", "Dag::Crash");
+        OutputCapture capture(4096);
+        Runner runner(reg, RunnerOptions{.workers = 2});
+        Expect(runner.RunAll()).ToEqual(1);
+        auto text = capture.Finish();
+        Expect(text.find("Dag::Builder")).ToBeLessThan(text.find("Dag::Reader"));
+        Expect(text.contains("[ SKIP ] Dag::NeedsCrash")).ToBeTrue();
+        Expect(text.contains("4 tests, 2 passed, 1 failed, 1 skipped")).ToBeTrue();
+    }
+
+    void TestWorkersBatchTinyTests() {
+        // Registry keeps views of the names, so they need stable storage.
+        std::vector<std::string> names;
+        names.reserve(500);
+        Registry reg;
+        for (int i = 0; i < 500; ++i) {
+            names.push_back("Pass" + std::to_string(i));
+            reg.Add<PassingSuite>("Passing", names.back(), &PassingSuite::Pass);
+        }
+        reg.Add<FailingSuite>("Failing", "FailAssert", &FailingSuite::FailAssert);
+        OutputCapture capture(std::size_t{1} << 20U);
+        Runner runner(reg, RunnerOptions{.workers = 3});
+        Expect(runner.RunAll()).ToEqual(1);
+        auto text = capture.Finish();
+        Expect(text.contains("501 tests, 500 passed, 1 failed")).ToBeTrue();
+        Expect(text.contains("[ PASS ] Passing::Pass499")).ToBeTrue();
+    }
+
+    void TestAdaptiveWorkers() {
+        Registry reg;
+        reg.Add<PassingSuite>("Passing", "Pass1", &PassingSuite::Pass);
+        reg.Add<PassingSuite>("Passing", "Pass2", &PassingSuite::Pass);
+        reg.Add<FailingSuite>("Failing", "FailAssert", &FailingSuite::FailAssert);
+        OutputCapture capture(4096);
+        Runner runner(reg, RunnerOptions{.adaptive_workers = true});
+        Expect(runner.RunAll()).ToEqual(1);
+        auto text = capture.Finish();
+        Expect(text.contains("[ PASS ] Passing::Pass2")).ToBeTrue();
+        Expect(text.contains("[ FAIL ] Failing::FailAssert")).ToBeTrue();
+    }
+
+    void TestWorkersFail() {
+        Registry reg;
+        reg.Add<PassingSuite>("Passing", "Pass", &PassingSuite::Pass);
+        reg.Add<FailingSuite>("Failing", "FailAssert", &FailingSuite::FailAssert);
+        OutputCapture capture(4096);
+        Runner runner(reg, RunnerOptions{.workers = 2});
+        Expect(runner.RunAll()).ToEqual(1);
+        auto text = capture.Finish();
+        Expect(text.contains("expected: 2")).ToBeTrue();
+    }
+
+    void TestWorkersAttributeCrash() {
+        Registry reg;
+        reg.Add<PassingSuite>("Passing", "Before", &PassingSuite::Pass);
+        reg.Add<CrashingSuite>("Crashing", "Abort", &CrashingSuite::Abort);
+        reg.Add<PassingSuite>("Passing", "After", &PassingSuite::Pass);
+        OutputCapture capture(4096);
+        Runner runner(reg, RunnerOptions{.workers = 1});
+        Expect(runner.RunAll()).ToEqual(1);
+        auto text = capture.Finish();
+        Expect(text.contains("[ FAIL ] Crashing::Abort")).ToBeTrue();
+        Expect(text.contains("worker crashed")).ToBeTrue();
+        Expect(text.contains("[ PASS ] Passing::After")).ToBeTrue();
+    }
+
+    void TestWorkersKeepLongOutput() {
+        Registry reg;
+        reg.Add<ChattySuite>("Chatty", "PrintLongAndFail", &ChattySuite::PrintLongAndFail);
+        OutputCapture capture(std::size_t{1} << 20U);
+        Runner runner(reg, RunnerOptions{.workers = 1});
+        Expect(runner.RunAll()).ToEqual(1);
+        auto text = capture.Finish();
+        Expect(text.contains("end of long output")).ToBeTrue();
+        Expect(text.contains("truncated")).ToBeFalse();
+        Expect(text.contains("expected: 2")).ToBeTrue();
+    }
+
+    void TestWorkerTextIsFreedAfterReport() {
+        using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace)
+        Registry reg;
+        reg.Add<PassingSuite>("Passing", "Loud", &PassingSuite::Pass);
+        const std::vector<TestEntry> tests(64, reg.Tests()[0]);
+        std::size_t reported = 0;
+        std::size_t held = 0;
+        ProcessPool pool(tests, 1);
+        pool.Run(
+            [](const TestEntry& entry) -> TestResult {
+                std::this_thread::sleep_for(2ms);  // one test per batch
+                return {.suite_name = entry.suite_name,
+                        .test_name = entry.test_name,
+                        .passed = false,
+                        .duration = {},
+                        .error = std::nullopt,
+                        .output = std::string(std::size_t{16} << 10U, 'x')};
+            },
+            [&](const TestResult& result) {
+                ++reported;
+                Expect(result.output.size()).ToEqual(std::size_t{16} << 10U);
+                held = std::max(held, ResultTextBytes());
+            });
+        Expect(reported).ToEqual(tests.size());
+        Expect(held).ToBeLessThan(std::size_t{512} << 10U);  // 1 MiB was written
+    }
+
+    void TestWorkerSetupFailureIsReported() {
+        Registry reg;
+        reg.Add<PassingSuite>("Passing", "Before", &PassingSuite::Pass);
+        reg.Add<PassingSuite>("Passing", "Broken", &PassingSuite::Pass);
+        reg.Add<PassingSuite>("Passing", "After", &PassingSuite::Pass);
+        std::vector<TestResult> results;
+        ProcessPool pool(reg.Tests(), 1);
+        pool.Run(
+            [](const TestEntry& entry) -> TestResult {
+                if (entry.test_name == "Broken") {
+                    throw std::runtime_error("capture unavailable");
+                }
+                return {.suite_name = entry.suite_name,
+                        .test_name = entry.test_name,
+                        .passed = true,
+                        .duration = {},
+                        .error = std::nullopt};
+            },
+            [&](TestResult result) { results.push_back(std::move(result)); });
+
+        Expect(results.size()).ToEqual(std::size_t{3});
+        for (const auto& result : results) {
+            Expect(result.passed).ToEqual(result.test_name != "Broken");
+            if (!result.passed) {
+                Expect(result.error->actual.contains("capture unavailable")).ToBeTrue();
+            }
+        }
+    }
+
+    void TestWorkersMemoryLimit() {
+#if defined(__linux__)
+        Registry reg;
+        reg.Add<PassingSuite>("Passing", "Pass", &PassingSuite::Pass);
+        reg.Add<HogSuite>("Hog", "AllocateGigabyte", &HogSuite::AllocateGigabyte);
+        OutputCapture capture(4096);
+        Runner runner(reg,
+                      RunnerOptions{.workers = 1, .max_memory_per_test = std::size_t{64} << 20U});
+        Expect(runner.RunAll()).ToEqual(1);
+        auto text = capture.Finish();
+        Expect(text.contains("[ PASS ] Passing::Pass")).ToBeTrue();
+        Expect(text.contains("exceeded memory limit")).ToBeTrue();
+        Expect(text.contains("(peak process RSS ")).ToBeTrue();
+#endif
+    }
+
+    void TestSoakFlagsDescriptorLeak() {
+#if defined(__linux__)
+        using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace)
+
+        Registry reg;
+        reg.Add<PassingSuite>("Passing", "Pass", &PassingSuite::Pass);
+        reg.Add<LeakySuite>("Leaky", "LeakDescriptor", &LeakySuite::LeakDescriptor);
+        auto series = std::filesystem::temp_directory_path() / "flul_soak_test.csv";
+        OutputCapture capture(4096);
+        Runner runner(reg, RunnerOptions{.soak = 200ms, .soak_output = series.string()});
+        auto status = runner.RunAll();
+        auto text = capture.Finish();
+        for (int fd : LeakySuite::leaked) {
+            ::close(fd);
+        }
+        LeakySuite::leaked.clear();
+
+        Expect(status).ToEqual(1);
+        Expect(text.contains("[ GROW ] Leaky::LeakDescriptor fds")).ToBeTrue();
+        Expect(text.contains("Passing::Pass")).ToBeFalse();
+
+        std::ifstream in(series);
+        std::string header;
+        std::string first;
+        std::getline(in, header);
+        Expect(header).ToEqual(std::string("elapsed_ms,iteration,rss_bytes,fds,threads"));
+        Expect(static_cast<bool>(std::getline(in, first))).ToBeTrue();
+        in.close();
+        std::filesystem::remove(series);
+#endif
+    }
+
     static void Register(Registry& r) {
         AddTests(r, "RunnerSuite",
                  {
@@ -84,6 +438,24 @@ class RunnerSuite : public Suite<RunnerSuite> {
                      {"TestRunAllFail", &RunnerSuite::TestRunAllFail},
                      {"TestCatchesStdException", &RunnerSuite::TestCatchesStdException},
                      {"TestCatchesUnknownException", &RunnerSuite::TestCatchesUnknownException},
+                     {"TestReplaysOutputOnFailure", &RunnerSuite::TestReplaysOutputOnFailure},
+                     {"TestHidesOutputOnPass", &RunnerSuite::TestHidesOutputOnPass},
+                     {"TestShowOutput", &RunnerSuite::TestShowOutput},
+                     {"TestGroupTiming", &RunnerSuite::TestGroupTiming},
+                     {"TestWorkersPass", &RunnerSuite::TestWorkersPass},
+                     {"TestDependenciesInProcess", &RunnerSuite::TestDependenciesInProcess},
+                     {"TestDependenciesWorkers", &RunnerSuite::TestDependenciesWorkers},
+                     {"TestWorkersBatchTinyTests", &RunnerSuite::TestWorkersBatchTinyTests},
+                     {"TestAdaptiveWorkers", &RunnerSuite::TestAdaptiveWorkers},
+                     {"TestWorkersFail", &RunnerSuite::TestWorkersFail},
+                     {"TestWorkersAttributeCrash", &RunnerSuite::TestWorkersAttributeCrash},
+                     {"TestWorkersKeepLongOutput", &RunnerSuite::TestWorkersKeepLongOutput},
+                     {"TestWorkerTextIsFreedAfterReport",
+                      &RunnerSuite::TestWorkerTextIsFreedAfterReport},
+                     {"TestWorkerSetupFailureIsReported",
+                      &RunnerSuite::TestWorkerSetupFailureIsReported},
+                     {"TestWorkersMemoryLimit", &RunnerSuite::TestWorkersMemoryLimit},
+                     {"TestSoakFlagsDescriptorLeak", &RunnerSuite::TestSoakFlagsDescriptorLeak},
                  });
     }
 };
@@ -25,18 +25,102 @@ void Register(flul::test::Registry& r);
 namespace fixture_test {
 void Register(flul::test::Registry& r);
 }
+namespace output_capture_test {
+void Register(flul::test::Registry& r);
+}
+namespace subprocess_test {
+void Register(flul::test::Registry& r);
+}
+namespace work_queue_test {
+void Register(flul::test::Registry& r);
+}
+namespace virtual_clock_test {
+void Register(flul::test::Registry& r);
+}
+namespace memory_limit_test {
+void Register(flul::test::Registry& r);
+}
+namespace soak_test {
+void Register(flul::test::Registry& r);
+}
+namespace bisect_test {
+void Register(flul::test::Registry& r);
+}
+namespace worker_tuner_test {
+void Register(flul::test::Registry& r);
+}
+namespace dependencies_test {
+void Register(flul::test::Registry& r);
+}
+namespace static_tests_test {
+void Register(flul::test::Registry& r);
+}
+namespace filter_test {
+void Register(flul::test::Registry& r);
+}
+namespace name_index_test {
+void Register(flul::test::Registry& r);
+}
+namespace name_trie_test {
+void Register(flul::test::Registry& r);
+}
+namespace string_table_test {
+void Register(flul::test::Registry& r);
+}
+namespace cases_test {
+void Register(flul::test::Registry& r);
+}
+namespace property_test {
+void Register(flul::test::Registry& r);
+}
+namespace fuzz_test {
+void Register(flul::test::Registry& r);
+}
+namespace tags_test {
+void Register(flul::test::Registry& r);
+}
+namespace manifest_test {
+void Register(flul::test::Registry& r);
+}
+namespace matrix_test {
+void Register(flul::test::Registry& r);
+}
+namespace soft_failures_test {
+void Register(flul::test::Registry& r);
+}
 
 auto main(int argc, char* argv[]) -> int {
     flul::test::Registry registry;
 
-    assertion_error_test::Register(registry);
-    stringify_test::Register(registry);
-    expect_test::Register(registry);
-    expect_callable_test::Register(registry);
-    registry_test::Register(registry);
-    runner_test::Register(registry);
-    run_test::Register(registry);
-    fixture_test::Register(registry);
+    registry.Defer("AssertionErrorSuite", &assertion_error_test::Register);
+    registry.Defer("StringifySuite", &stringify_test::Register);
+    registry.Defer("ExpectSuite", &expect_test::Register);
+    registry.Defer("ExpectCallableSuite", &expect_callable_test::Register);
+    registry.Defer("RegistrySuite", &registry_test::Register);
+    registry.Defer("RunnerSuite", &runner_test::Register);
+    registry.Defer("RunSuite", &run_test::Register);
+    registry.Defer("FixtureSuite", &fixture_test::Register);
+    registry.Defer("OutputCaptureSuite", &output_capture_test::Register);
+    registry.Defer("SubprocessSuite", &subprocess_test::Register);
+    registry.Defer("WorkQueueSuite", &work_queue_test::Register);
+    registry.Defer("VirtualClockSuite", &virtual_clock_test::Register);
+    registry.Defer("MemoryLimitSuite", &memory_limit_test::Register);
+    registry.Defer("SoakSuite", &soak_test::Register);
+    registry.Defer("BisectSuite", &bisect_test::Register);
+    registry.Defer("WorkerTunerSuite", &worker_tuner_test::Register);
+    registry.Defer("DependenciesSuite", &dependencies_test::Register);
+    registry.Defer("StaticTestsSuite", &static_tests_test::Register);
+    registry.Defer("FilterSuite", &filter_test::Register);
+    registry.Defer("NameIndexSuite", &name_index_test::Register);
+    registry.Defer("NameTrieSuite", &name_trie_test::Register);
+    registry.Defer("StringTableSuite", &string_table_test::Register);
+    registry.Defer("CasesSuite", &cases_test::Register);
+    registry.Defer("PropertySuite", &property_test::Register);
+    registry.Defer("FuzzTestSuite", &fuzz_test::Register);
+    registry.Defer("TagsSuite", &tags_test::Register);
+    registry.Defer("ManifestSuite", &manifest_test::Register);
+    registry.Defer("MatrixSuite", &matrix_test::Register);
+    registry.Defer("SoftFailuresSuite", &soft_failures_test::Register);
 
     return flul::test::Run(argc, argv, registry);
 }
@@ -0,0 +1,102 @@
+#include "flul/test/soak.hpp"
+
+#include <cstddef>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::Expect;
+using flul::test::Registry;
+using flul::test::ResourceSample;
+using flul::test::SampleResources;
+using flul::test::SoakMonitor;
+using flul::test::Suite;
+using flul::test::TrendFit;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class SoakSuite : public Suite<SoakSuite> {
+   public:
+    void TestTrendFitLine() {
+        TrendFit fit;
+        for (int x = 0; x < 10; ++x) {
+            fit.Add(x, (3.0 * x) + 7.0);
+        }
+        Expect(fit.Count()).ToEqual(std::size_t{10});
+        Expect(fit.Slope()).ToBeGreaterThan(2.999);
+        Expect(fit.Slope()).ToBeLessThan(3.001);
+        Expect(fit.RSquared()).ToBeGreaterThan(0.999);
+    }
+
+    void TestTrendFitFlat() {
+        TrendFit fit;
+        for (int x = 0; x < 10; ++x) {
+            fit.Add(x, 5.0);
+        }
+        Expect(fit.Slope()).ToEqual(0.0);
+        Expect(fit.RSquared()).ToEqual(0.0);
+    }
+
+    void TestTrendFitNoise() {
+        TrendFit fit;
+        for (int x = 0; x < 20; ++x) {
+            fit.Add(x, x % 2 == 0 ? 1.0 : -1.0);
+        }
+        Expect(fit.RSquared()).ToBeLessThan(0.1);
+    }
+
+    void TestMonitorFlagsSteadyGrowth() {
+        SoakMonitor monitor(2);
+        for (std::size_t i = 0; i < 20; ++i) {
+            ResourceSample before{.rss = 1 << 20, .fds = 10, .threads = 1};
+            auto leaking = before;
+            leaking.fds += 1;
+            monitor.Record(0, i, before, before);
+            monitor.Record(1, i, before, leaking);
+        }
+        auto flagged = monitor.Flagged();
+        Expect(flagged.size()).ToEqual(std::size_t{1});
+        Expect(flagged[0].test).ToEqual(std::size_t{1});
+        Expect(ResourceSample::MetricName(flagged[0].metric) == "fds").ToBeTrue();
+    }
+
+    void TestMonitorIgnoresShortRuns() {
+        SoakMonitor monitor(1);
+        for (std::size_t i = 0; i < SoakMonitor::kWarmupIterations + 3; ++i) {
+            ResourceSample before{.rss = 0, .fds = 10, .threads = 1};
+            auto after = before;
+            after.fds += 1;
+            monitor.Record(0, i, before, after);
+        }
+        Expect(monitor.Flagged().empty()).ToBeTrue();
+    }
+
+    void TestSampleResources() {
+#if defined(__linux__)
+        auto sample = SampleResources();
+        Expect(sample.rss).ToBeGreaterThan(std::size_t{0});
+        Expect(sample.threads).ToBeGreaterThan(std::size_t{0});
+        Expect(sample.fds).ToBeGreaterThan(std::size_t{0});
+#endif
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "SoakSuite",
+                 {
+                     {"TestTrendFitLine", &SoakSuite::TestTrendFitLine},
+                     {"TestTrendFitFlat", &SoakSuite::TestTrendFitFlat},
+                     {"TestTrendFitNoise", &SoakSuite::TestTrendFitNoise},
+                     {"TestMonitorFlagsSteadyGrowth", &SoakSuite::TestMonitorFlagsSteadyGrowth},
+                     {"TestMonitorIgnoresShortRuns", &SoakSuite::TestMonitorIgnoresShortRuns},
+                     {"TestSampleResources", &SoakSuite::TestSampleResources},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace soak_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    SoakSuite::Register(r);
+}
+}  // namespace soak_test
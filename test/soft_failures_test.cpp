@@ -0,0 +1,167 @@
+#include "flul/test/soft_failures.hpp"
+
+#include <cstddef>
+#include <format>
+#include <string>
+#include <thread>
+
+#include "flul/test/assertion_error.hpp"
+#include "flul/test/expect.hpp"
+#include "flul/test/expect_callable.hpp"
+#include "flul/test/output_capture.hpp"
+#include "flul/test/property.hpp"
+#include "flul/test/registry.hpp"
+#include "flul/test/runner.hpp"
+
+using flul::test::AssertionError;
+using flul::test::CheckProperty;
+using flul::test::Expect;
+using flul::test::ExpectCallable;
+using flul::test::ExpectSoft;
+using flul::test::Integers;
+using flul::test::OutputCapture;
+using flul::test::PropertyOptions;
+using flul::test::Registry;
+using flul::test::Runner;
+using flul::test::RunnerOptions;
+using flul::test::SoftFailures;
+using flul::test::Suite;
+
+namespace {
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+class SoftSampleSuite : public Suite<SoftSampleSuite> {
+   public:
+    void ThenFatal() {
+        ExpectSoft(1).ToEqual(2);
+        ExpectSoft(std::string("abc")).ToEqual(std::string("abd"));
+        Expect(3).ToEqual(4);
+        ExpectSoft(5).ToEqual(6);  // not reached
+    }
+
+    void Many() {
+        for (int i = 0; i < 100; ++i) {
+            ExpectSoft(i).ToBeLessThan(10);
+        }
+    }
+
+    void AllHold() {
+        ExpectSoft(7).ToBeGreaterThan(1).ToBeLessThan(9);
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static)
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class SoftFailuresSuite : public Suite<SoftFailuresSuite> {
+   public:
+    void TestRecordsAndKeepsRunning() {
+        SoftFailures soft;
+        auto reached = 0;
+        for (int i = 0; i < 40; ++i) {
+            ExpectSoft(i).ToEqual(-1).ToBeGreaterThan(100);
+            ++reached;
+        }
+        Expect(reached).ToEqual(40);
+        Expect(soft.Count()).ToEqual(std::size_t{80});
+        Expect(soft.Failures().size()).ToEqual(SoftFailures::kStoreLimit);
+        Expect(soft.Failures()[1].expected).ToEqual(std::string("greater than 100"));
+    }
+
+    void TestCollectorsNest() {
+        SoftFailures outer;
+        {
+            SoftFailures inner;
+            ExpectSoft(true).ToBeFalse();
+            Expect(SoftFailures::Current() == &inner).ToBeTrue();
+            Expect(inner.Count()).ToEqual(std::size_t{1});
+        }
+        Expect(SoftFailures::Current() == &outer).ToBeTrue();
+        Expect(outer.Count()).ToEqual(std::size_t{0});
+    }
+
+    void TestThrowsWithoutCollector() {
+        auto threw = false;
+        std::thread([&] {
+            try {
+                ExpectSoft(1).ToNotEqual(1);
+            } catch (const AssertionError&) {
+                threw = true;
+            }
+        }).join();
+        Expect(threw).ToBeTrue();
+    }
+
+    void TestSuspendedInsideProperty() {
+        SoftFailures soft;
+        for (std::size_t threads : {1U, 4U}) {
+            PropertyOptions options{.cases = 200, .seed = 1, .threads = threads};
+            ExpectCallable([&] {
+                CheckProperty(Integers<int>(0, 100), [](int x) { ExpectSoft(x).ToBeLessThan(50); },
+                              options);
+            }).ToThrow<AssertionError>();
+        }
+        Expect(soft.Count()).ToEqual(std::size_t{0});
+    }
+
+    void TestSuspendedInsideExpectCallable() {
+        SoftFailures soft;
+        ExpectCallable([] { ExpectSoft(1).ToEqual(2); }).ToThrow<AssertionError>();
+        Expect(soft.Count()).ToEqual(std::size_t{0});
+        Expect(SoftFailures::Current() == &soft).ToBeTrue();
+    }
+
+    void TestRunnerReportsEveryFailure() {
+        for (std::size_t workers : {0U, 2U}) {
+            Registry reg;
+            reg.Add<SoftSampleSuite>("Soft", "ThenFatal", &SoftSampleSuite::ThenFatal);
+            reg.Add<SoftSampleSuite>("Soft", "Many", &SoftSampleSuite::Many);
+            reg.Add<SoftSampleSuite>("Soft", "AllHold", &SoftSampleSuite::AllHold);
+            OutputCapture capture(16384);
+            Runner runner(reg, RunnerOptions{.workers = workers});
+            Expect(runner.RunAll()).ToEqual(1);
+            auto text = capture.Finish();
+
+            Expect(text.contains("[ FAIL ] Soft::ThenFatal")).ToBeTrue();
+            auto first = text.find("expected: 2");
+            auto second = text.find("expected: abd");
+            auto fatal = text.find("expected: 4");
+            Expect(first < second && second < fatal && fatal != std::string::npos).ToBeTrue();
+            Expect(text.contains("expected: 6")).ToBeFalse();
+
+            Expect(text.contains("[ FAIL ] Soft::Many")).ToBeTrue();
+            for (int i = 10; i < 10 + static_cast<int>(SoftFailures::kStoreLimit); ++i) {
+                Expect(text.contains(std::format("actual: {}\n", i))).ToBeTrue();
+            }
+            Expect(text.contains("... 58 more failures not stored")).ToBeTrue();  // 90 failed
+            Expect(text.contains("[ PASS ] Soft::AllHold")).ToBeTrue();
+        }
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "SoftFailuresSuite",
+                 {
+                     {"TestRecordsAndKeepsRunning", &SoftFailuresSuite::TestRecordsAndKeepsRunning},
+                     {"TestCollectorsNest", &SoftFailuresSuite::TestCollectorsNest},
+                     {"TestThrowsWithoutCollector", &SoftFailuresSuite::TestThrowsWithoutCollector},
+                     {"TestSuspendedInsideProperty",
+                      &SoftFailuresSuite::TestSuspendedInsideProperty},
+                     {"TestSuspendedInsideExpectCallable",
+                      &SoftFailuresSuite::TestSuspendedInsideExpectCallable},
+                     {"TestRunnerReportsEveryFailure",
+                      &SoftFailuresSuite::TestRunnerReportsEveryFailure},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace soft_failures_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    SoftFailuresSuite::Register(r);
+}
+}  // namespace soft_failures_test
@@ -0,0 +1,184 @@
+#include "flul/test/static_tests.hpp"
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/output_capture.hpp"
+#include "flul/test/registry.hpp"
+#include "flul/test/run.hpp"
+#include "flul/test/runner.hpp"
+
+using flul::test::Expect;
+using flul::test::JoinTables;
+using flul::test::OutputCapture;
+using flul::test::Registry;
+using flul::test::Runner;
+using flul::test::RunnerOptions;
+using flul::test::StaticTest;
+using flul::test::Suite;
+using flul::test::TestEntry;
+
+namespace {
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+int g_runs = 0;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+class TableSuite : public Suite<TableSuite> {
+   public:
+    void SetUp() override {
+        ++g_runs;
+    }
+
+    void First() {}
+
+    void Second() {
+        Expect(g_runs).ToBeGreaterThan(0);
+    }
+};
+
+class OtherTableSuite : public Suite<OtherTableSuite> {
+   public:
+    void Only() {}
+};
+
+class PipelineSuite : public Suite<PipelineSuite> {
+   public:
+    void Prepare() {}
+    void Use() {}
+    void Unrelated() {}
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static)
+
+constexpr std::array kTableTests = {
+    StaticTest<&TableSuite::First>("TableSuite", "First"),
+    StaticTest<&TableSuite::Second>("TableSuite", "Second"),
+};
+
+constexpr std::array kOtherTests = {
+    StaticTest<&OtherTableSuite::Only>("OtherTableSuite", "Only"),
+};
+
+constexpr auto kAllTests = JoinTables(kTableTests, kOtherTests);
+
+constexpr std::array kPipelineTests = {
+    StaticTest<&PipelineSuite::Prepare>("PipelineSuite", "Prepare"),
+    StaticTest<&PipelineSuite::Use>("PipelineSuite", "Use"),
+    StaticTest<&PipelineSuite::Unrelated>("PipelineSuite", "Unrelated"),
+};
+
+constexpr auto kRunTests = JoinTables(kTableTests, kPipelineTests);
+
+auto MakeArgv(std::initializer_list<const char*> args) -> std::vector<char*> {
+    std::vector<char*> argv;
+    for (const auto* a : args) {
+        argv.push_back(const_cast<char*>(a));  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+    return argv;
+}
+
+static_assert(std::is_trivially_copyable_v<TestEntry>);
+static_assert(kAllTests.size() == 3);
+static_assert(kAllTests[2].suite_name == "OtherTableSuite");
+static_assert(kAllTests[0].callable.invoke != kAllTests[1].callable.invoke);
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class StaticTestsSuite : public Suite<StaticTestsSuite> {
+   public:
+    void TestRegistryViewsTable() {
+        Registry reg(kAllTests);
+        Expect(reg.Tests().data() == kAllTests.data()).ToBeTrue();
+        Expect(reg.Tests().size()).ToEqual(std::size_t{3});
+    }
+
+    void TestTableEntriesRunLifecycle() {
+        g_runs = 0;
+        for (const auto& entry : kAllTests) {
+            if (entry.suite_name == "TableSuite") {
+                entry.callable();
+            }
+        }
+        Expect(g_runs).ToEqual(2);
+    }
+
+    void TestFilterCopiesTable() {
+        Registry reg(kAllTests);
+        reg.Filter("Other");
+        Expect(reg.Tests().size()).ToEqual(std::size_t{1});
+        Expect(reg.Tests()[0].test_name).ToEqual(std::string_view("Only"));
+        Expect(kAllTests.size()).ToEqual(std::size_t{3});
+    }
+
+    void TestAddAfterTable() {
+        Registry reg(kTableTests);
+        reg.Add<OtherTableSuite>("OtherTableSuite", "Added", &OtherTableSuite::Only);
+        Expect(reg.Tests().size()).ToEqual(std::size_t{3});
+        Expect(reg.Tests()[2].test_name).ToEqual(std::string_view("Added"));
+        reg.Tests()[2].callable();
+    }
+
+    void TestRunnerRunsTable() {
+        for (std::size_t workers : {0U, 2U}) {
+            Registry reg(kRunTests);
+            g_runs = 0;
+            OutputCapture capture(16384);
+            Runner runner(reg, RunnerOptions{.workers = workers});
+            Expect(runner.RunAll()).ToEqual(0);
+            auto text = capture.Finish();
+            Expect(reg.Tests().data() == kRunTests.data()).ToBeTrue();
+            Expect(text.contains("[ PASS ] TableSuite::Second")).ToBeTrue();
+            Expect(text.contains("[ PASS ] PipelineSuite::Unrelated")).ToBeTrue();
+            Expect(g_runs).ToEqual(workers == 0 ? 2 : 0);  // workers run tests in children
+        }
+    }
+
+    void TestRunSelectsFromTable() {
+        for (const char* workers : {"0", "2"}) {
+            Registry reg(kRunTests);
+            reg.Depend("PipelineSuite::Use", "PipelineSuite::Prepare");
+            auto argv = MakeArgv({"prog", "--filter", "PipelineSuite::Use", "--workers", workers});
+            OutputCapture capture(16384);
+            auto status = flul::test::Run(static_cast<int>(argv.size()), argv.data(), reg);
+            auto text = capture.Finish();
+            Expect(status).ToEqual(0);
+            Expect(reg.Tests().size()).ToEqual(std::size_t{2});
+            auto prepare = text.find("[ PASS ] PipelineSuite::Prepare");
+            auto use = text.find("[ PASS ] PipelineSuite::Use");
+            Expect(prepare != std::string::npos && use != std::string::npos).ToBeTrue();
+            Expect(text.contains("Unrelated")).ToBeFalse();
+            Expect(text.contains("TableSuite")).ToBeFalse();
+        }
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "StaticTestsSuite",
+                 {
+                     {"TestRegistryViewsTable", &StaticTestsSuite::TestRegistryViewsTable},
+                     {"TestTableEntriesRunLifecycle",
+                      &StaticTestsSuite::TestTableEntriesRunLifecycle},
+                     {"TestFilterCopiesTable", &StaticTestsSuite::TestFilterCopiesTable},
+                     {"TestAddAfterTable", &StaticTestsSuite::TestAddAfterTable},
+                     {"TestRunnerRunsTable", &StaticTestsSuite::TestRunnerRunsTable},
+                     {"TestRunSelectsFromTable", &StaticTestsSuite::TestRunSelectsFromTable},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace static_tests_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    StaticTestsSuite::Register(r);
+}
+}  // namespace static_tests_test
@@ -0,0 +1,80 @@
+#include "flul/test/string_table.hpp"
+
+#include <cstddef>
+#include <format>
+#include <string>
+#include <string_view>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::Expect;
+using flul::test::Registry;
+using flul::test::StringTable;
+using flul::test::Suite;
+
+namespace {
+
+class DummySuite : public Suite<DummySuite> {
+   public:
+    void Pass() {}
+};
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class StringTableSuite : public Suite<StringTableSuite> {
+   public:
+    void TestDeduplicates() {
+        StringTable table;
+        auto math = table.Intern("Math");
+        Expect(table.Intern("Io")).ToEqual(std::string_view("Io"));
+        Expect(table.Intern(std::string("Ma") + "th").data()).ToEqual(math.data());
+        Expect(table.Size()).ToEqual(std::size_t{2});
+    }
+
+    void TestViewsStayValid() {
+        StringTable table;
+        auto first = table.Intern("Case/0");
+        std::string_view last;
+        for (int i = 1; i < 1000; ++i) {
+            last = table.Intern(std::format("Case/{}", i));
+        }
+        Expect(first).ToEqual(std::string_view("Case/0"));
+        Expect(last).ToEqual(std::string_view("Case/999"));
+    }
+
+    void TestRegistryInternOutlivesSource() {
+        Registry copy;
+        {
+            Registry reg;
+            for (int i = 0; i < 3; ++i) {
+                auto name = std::format("Case/{}", i);
+                reg.Add<DummySuite>("Dummy", reg.Intern(name), &DummySuite::Pass);
+            }
+            Expect(reg.Intern("Case/1").data()).ToEqual(reg.Tests()[1].test_name.data());
+            copy = reg;
+        }
+        Expect(copy.Tests().size()).ToEqual(std::size_t{3});
+        Expect(copy.Tests()[2].test_name).ToEqual(std::string_view("Case/2"));
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "StringTableSuite",
+                 {
+                     {"TestDeduplicates", &StringTableSuite::TestDeduplicates},
+                     {"TestViewsStayValid", &StringTableSuite::TestViewsStayValid},
+                     {"TestRegistryInternOutlivesSource",
+                      &StringTableSuite::TestRegistryInternOutlivesSource},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace string_table_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    StringTableSuite::Register(r);
+}
+}  // namespace string_table_test
@@ -0,0 +1,110 @@
+#include "flul/test/subprocess.hpp"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::ChildOutcome;
+using flul::test::Expect;
+using flul::test::Registry;
+using flul::test::RunInChild;
+using flul::test::Suite;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class SubprocessSuite : public Suite<SubprocessSuite> {
+   public:
+    void TestReturned() {
+        auto fn = [] {};
+        auto outcome = RunInChild(fn);
+        Expect(outcome.kind == ChildOutcome::Kind::kReturned).ToBeTrue();
+    }
+
+    void TestThrew() {
+        auto fn = [] { throw std::runtime_error("escape"); };
+        auto outcome = RunInChild(fn);
+        Expect(outcome.kind == ChildOutcome::Kind::kThrew).ToBeTrue();
+    }
+
+    void TestExitCode() {
+        auto fn = [] { ::_exit(7); };
+        auto outcome = RunInChild(fn);
+        Expect(outcome.kind == ChildOutcome::Kind::kExited).ToBeTrue();
+        Expect(outcome.code).ToEqual(7);
+    }
+
+    void TestSignal() {
+        auto fn = [] { std::raise(SIGKILL); };
+        auto outcome = RunInChild(fn);
+        Expect(outcome.kind == ChildOutcome::Kind::kSignaled).ToBeTrue();
+        Expect(outcome.code).ToEqual(SIGKILL);
+    }
+
+    void TestStderrLimit() {
+        auto fn = [] { std::fputs("0123456789", stderr); };
+        auto outcome = RunInChild(fn, 4);
+        Expect(outcome.stderr_text).ToEqual(std::string("0123"));
+    }
+
+    void TestTimeoutKillsChild() {
+        using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace)
+        auto fn = [] {
+            for (;;) {
+                ::pause();
+            }
+        };
+        auto start = std::chrono::steady_clock::now();
+        auto outcome = RunInChild(fn, 1024, 100ms);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Expect(outcome.kind == ChildOutcome::Kind::kTimedOut).ToBeTrue();
+        Expect(outcome.code).ToEqual(100);
+        Expect(elapsed < 5s).ToBeTrue();
+    }
+
+    void TestGrandchildHoldingPipesDoesNotBlock() {
+        using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace)
+        auto fn = [] {
+            std::fputs("child", stderr);
+            std::fflush(stderr);
+            if (::fork() == 0) {
+                ::sleep(1);  // keeps the inherited stderr and status pipes open
+                ::_exit(0);
+            }
+        };
+        auto start = std::chrono::steady_clock::now();
+        auto outcome = RunInChild(fn);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Expect(outcome.kind == ChildOutcome::Kind::kReturned).ToBeTrue();
+        Expect(outcome.stderr_text).ToEqual(std::string("child"));
+        Expect(elapsed < 500ms).ToBeTrue();
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "SubprocessSuite",
+                 {
+                     {"TestReturned", &SubprocessSuite::TestReturned},
+                     {"TestThrew", &SubprocessSuite::TestThrew},
+                     {"TestExitCode", &SubprocessSuite::TestExitCode},
+                     {"TestSignal", &SubprocessSuite::TestSignal},
+                     {"TestStderrLimit", &SubprocessSuite::TestStderrLimit},
+                     {"TestTimeoutKillsChild", &SubprocessSuite::TestTimeoutKillsChild},
+                     {"TestGrandchildHoldingPipesDoesNotBlock",
+                      &SubprocessSuite::TestGrandchildHoldingPipesDoesNotBlock},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace subprocess_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    SubprocessSuite::Register(r);
+}
+}  // namespace subprocess_test
@@ -0,0 +1,148 @@
+#include "flul/test/tags.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/expect_callable.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::Expect;
+using flul::test::ExpectCallable;
+using flul::test::Registry;
+using flul::test::Suite;
+using flul::test::TagExpression;
+using flul::test::TestEntry;
+
+namespace {
+
+class DummySuite : public Suite<DummySuite> {
+   public:
+    void Pass() {}
+};
+
+constexpr std::array<std::string_view, 3> kTagNames = {"slow", "io", "smoke"};
+constexpr std::uint64_t kSlow = 1;
+constexpr std::uint64_t kIo = 2;
+constexpr std::uint64_t kSmoke = 4;
+
+// Entries tagged with `tags`, in order.
+auto MakeTests(std::initializer_list<std::uint64_t> tags) -> std::vector<TestEntry> {
+    std::vector<TestEntry> tests;
+    for (auto bits : tags) {
+        tests.push_back({.suite_name = "S", .test_name = "T", .callable = {}, .tags = bits});
+    }
+    return tests;
+}
+
+// The bitmap of `expression` over `tests` as a string of '0'/'1', test 0 first.
+auto Selected(std::string_view expression, const std::vector<TestEntry>& tests) -> std::string {
+    auto bitmap = TagExpression(expression).Evaluate(tests, kTagNames);
+    std::string selected;
+    for (std::size_t i = 0; i < tests.size(); ++i) {
+        selected += ((bitmap[i / 64] >> (i % 64)) & 1U) != 0 ? '1' : '0';
+    }
+    return selected;
+}
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class TagsSuite : public Suite<TagsSuite> {
+   public:
+    void TestOperators() {
+        auto tests = MakeTests({0, kSlow, kIo, kSlow | kIo, kSmoke, kSlow | kSmoke});
+        Expect(Selected("slow", tests)).ToEqual(std::string("010101"));
+        Expect(Selected("slow and io", tests)).ToEqual(std::string("000100"));
+        Expect(Selected("slow | io", tests)).ToEqual(std::string("011101"));
+        Expect(Selected("!slow", tests)).ToEqual(std::string("101010"));
+        Expect(Selected("slow & not (io or smoke)", tests)).ToEqual(std::string("010000"));
+    }
+
+    void TestAndBindsTighterThanOr() {
+        auto tests = MakeTests({kSmoke, kSlow, kSlow | kIo});
+        Expect(Selected("smoke or slow and io", tests)).ToEqual(std::string("101"));
+        Expect(Selected("(smoke or slow) and io", tests)).ToEqual(std::string("001"));
+    }
+
+    void TestNotStaysWithinRegistry() {
+        std::vector<TestEntry> tests(70);
+        tests[3].tags = kSlow;
+        auto bitmap = TagExpression("not slow").Evaluate(tests, kTagNames);
+        Expect(bitmap.size()).ToEqual(std::size_t{2});
+        Expect(std::popcount(bitmap[0]) + std::popcount(bitmap[1])).ToEqual(69);
+    }
+
+    void TestKeywordPrefixedTagsAndUnknownTags() {
+        auto tests = MakeTests({kSlow, 0});
+        Expect(Selected("notable", tests)).ToEqual(std::string("00"));
+        Expect(Selected("not notable", tests)).ToEqual(std::string("11"));
+        Expect(Selected("nightly or slow", tests)).ToEqual(std::string("10"));
+    }
+
+    void TestMalformedExpressions() {
+        for (auto text : {"", "slow and", "(io", "io)", "slow io", "and", "slow ^ io"}) {
+            ExpectCallable([&] { TagExpression expression(text); })
+                .ToThrow<std::invalid_argument>();
+        }
+    }
+
+    void TestRegistryTagsAndFilter() {
+        Registry reg;
+        DummySuite::AddTests(reg, "Db", {"io", "slow"},
+                             {{"Load", &DummySuite::Pass}, {"Scan", &DummySuite::Pass}});
+        reg.Add<DummySuite>("Db", "Parse", &DummySuite::Pass, {"smoke"});
+        reg.Add<DummySuite>("Db", "Plain", &DummySuite::Pass);
+        reg.Depend("Db::Parse", "Db::Load");
+
+        Expect(reg.TagNames().size()).ToEqual(std::size_t{3});
+        Expect(reg.TagNames()[2]).ToEqual(std::string_view("smoke"));
+        Expect(reg.Tests()[1].tags).ToEqual(std::uint64_t{3});
+
+        reg.FilterTags(TagExpression("smoke or not (io or smoke)"));
+        Expect(reg.Tests().size()).ToEqual(std::size_t{3});  // Parse, Plain and Load
+        Expect(reg.Tests()[0].test_name).ToEqual(std::string_view("Load"));
+        Expect(reg.Tests()[1].test_name).ToEqual(std::string_view("Parse"));
+    }
+
+    void TestAtMost64Tags() {
+        Registry reg;
+        for (int i = 0; i < 64; ++i) {
+            reg.Add<DummySuite>("S", "T", &DummySuite::Pass, {reg.Intern(std::format("t{}", i))});
+        }
+        ExpectCallable([&] {
+            reg.Add<DummySuite>("S", "T", &DummySuite::Pass, {"one-too-many"});
+        }).ToThrow<std::invalid_argument>();
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "TagsSuite",
+                 {
+                     {"TestOperators", &TagsSuite::TestOperators},
+                     {"TestAndBindsTighterThanOr", &TagsSuite::TestAndBindsTighterThanOr},
+                     {"TestNotStaysWithinRegistry", &TagsSuite::TestNotStaysWithinRegistry},
+                     {"TestKeywordPrefixedTagsAndUnknownTags",
+                      &TagsSuite::TestKeywordPrefixedTagsAndUnknownTags},
+                     {"TestMalformedExpressions", &TagsSuite::TestMalformedExpressions},
+                     {"TestRegistryTagsAndFilter", &TagsSuite::TestRegistryTagsAndFilter},
+                     {"TestAtMost64Tags", &TagsSuite::TestAtMost64Tags},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace tags_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    TagsSuite::Register(r);
+}
+}  // namespace tags_test
@@ -0,0 +1,132 @@
+#include "flul/test/virtual_clock.hpp"
+
+#include <chrono>
+#include <latch>
+#include <string>
+#include <thread>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/output_capture.hpp"
+#include "flul/test/registry.hpp"
+#include "flul/test/runner.hpp"
+
+using flul::test::Expect;
+using flul::test::OutputCapture;
+using flul::test::Registry;
+using flul::test::Runner;
+using flul::test::Suite;
+using flul::test::VirtualClock;
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+class SleepySuite : public Suite<SleepySuite> {
+   public:
+    void SleepFiveSeconds() {
+        Clock().SleepFor(5s);
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static)
+
+}  // namespace
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class VirtualClockSuite : public Suite<VirtualClockSuite> {
+   public:
+    void TestStartsAtEpoch() {
+        Expect(Clock().Elapsed() == VirtualClock::duration::zero()).ToBeTrue();
+    }
+
+    void TestAdvance() {
+        Clock().Advance(3s);
+        Expect(Clock().Elapsed() == 3s).ToBeTrue();
+    }
+
+    void TestStaticNowReadsTestClock() {
+        Clock().Advance(42ms);
+        Expect(VirtualClock::now().time_since_epoch() == 42ms).ToBeTrue();
+    }
+
+    void TestSleepAutoAdvances() {
+        auto start = std::chrono::steady_clock::now();
+        Clock().SleepFor(1h);
+        Expect(Clock().Elapsed() == 1h).ToBeTrue();
+        Expect(std::chrono::steady_clock::now() - start < 1s).ToBeTrue();
+    }
+
+    void TestParticipantsWakeInDeadlineOrder() {
+        VirtualClock clock;
+        VirtualClock::time_point woke{};
+        std::latch joined(1);
+        {
+            std::jthread worker([&clock, &woke, &joined] {
+                VirtualClock::Participant participant(clock);
+                joined.count_down();
+                clock.SleepFor(10s);
+                woke = clock.Now();
+            });
+            joined.wait();
+            clock.SleepFor(20s);
+        }
+        Expect(woke.time_since_epoch() == 10s).ToBeTrue();
+        Expect(clock.Elapsed() == 20s).ToBeTrue();
+    }
+
+    void TestNoAutoAdvanceWaitsForAdvance() {
+        VirtualClock clock;
+        clock.SetAutoAdvance(false);
+        std::jthread worker([&clock] { clock.SleepUntil(VirtualClock::time_point{1s}); });
+        clock.Advance(1s);
+        worker.join();
+        Expect(clock.Elapsed() == 1s).ToBeTrue();
+    }
+
+    void TestInstalledOnFirstUse() {
+        Expect(VirtualClock::now() == VirtualClock::time_point{}).ToBeTrue();
+        Clock().Advance(5s);
+        Expect(VirtualClock::now().time_since_epoch() == 5s).ToBeTrue();
+        flul::test::RunTestMethod(&SleepySuite::SleepFiveSeconds);
+        Expect(VirtualClock::now().time_since_epoch() == 5s).ToBeTrue();  // ours again
+    }
+
+    void TestRunnerReportsSimulatedTime() {
+        Registry reg;
+        reg.Add<SleepySuite>("Sleepy", "SleepFiveSeconds", &SleepySuite::SleepFiveSeconds);
+        OutputCapture capture(4096);
+        Runner runner(reg);
+        runner.RunAll();
+        auto text = capture.Finish();
+        Expect(text.contains("simulated 5.00s")).ToBeTrue();
+    }
+
+    static void Register(Registry& r) {
+        AddTests(
+            r, "VirtualClockSuite",
+            {
+                {"TestStartsAtEpoch", &VirtualClockSuite::TestStartsAtEpoch},
+                {"TestAdvance", &VirtualClockSuite::TestAdvance},
+                {"TestStaticNowReadsTestClock", &VirtualClockSuite::TestStaticNowReadsTestClock},
+                {"TestSleepAutoAdvances", &VirtualClockSuite::TestSleepAutoAdvances},
+                {"TestParticipantsWakeInDeadlineOrder",
+                 &VirtualClockSuite::TestParticipantsWakeInDeadlineOrder},
+                {"TestNoAutoAdvanceWaitsForAdvance",
+                 &VirtualClockSuite::TestNoAutoAdvanceWaitsForAdvance},
+                {"TestInstalledOnFirstUse", &VirtualClockSuite::TestInstalledOnFirstUse},
+                {"TestRunnerReportsSimulatedTime",
+                 &VirtualClockSuite::TestRunnerReportsSimulatedTime},
+            });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace virtual_clock_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    VirtualClockSuite::Register(r);
+}
+}  // namespace virtual_clock_test
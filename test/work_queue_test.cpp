@@ -0,0 +1,121 @@
+#include "flul/test/work_queue.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+#include "flul/test/subprocess.hpp"
+
+using flul::test::BatchSizer;
+using flul::test::Expect;
+using flul::test::Registry;
+using flul::test::RunInChild;
+using flul::test::SharedArray;
+using flul::test::Suite;
+using flul::test::WorkQueue;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class WorkQueueSuite : public Suite<WorkQueueSuite> {
+   public:
+    void TestPushClaimFifo() {
+        WorkQueue queue(4);
+        queue.Push(7);
+        queue.Push(9);
+        std::array<std::uint32_t, 1> out{};
+        Expect(queue.Claim(out)).ToEqual(std::size_t{1});
+        Expect(out[0]).ToEqual(std::uint32_t{7});
+        Expect(queue.Claim(out)).ToEqual(std::size_t{1});
+        Expect(out[0]).ToEqual(std::uint32_t{9});
+        Expect(queue.Claim(out)).ToEqual(std::size_t{0});
+    }
+
+    void TestClaimBatch() {
+        WorkQueue queue(4);
+        queue.Push(1);
+        queue.Push(2);
+        queue.Push(3);
+        std::array<std::uint32_t, 2> out{};
+        Expect(queue.Claim(out)).ToEqual(std::size_t{2});
+        Expect(queue.Size()).ToEqual(std::size_t{1});
+    }
+
+    void TestFullQueueRejectsPush() {
+        WorkQueue queue(2);
+        Expect(queue.Push(1)).ToBeTrue();
+        Expect(queue.Push(2)).ToBeTrue();
+        Expect(queue.Push(3)).ToBeFalse();
+    }
+
+    void TestWrapAround() {
+        WorkQueue queue(2);
+        std::array<std::uint32_t, 1> out{};
+        for (std::uint32_t i = 0; i < 5; ++i) {
+            queue.Push(i);
+            queue.Claim(out);
+            Expect(out[0]).ToEqual(i);
+        }
+    }
+
+    void TestSharedAcrossFork() {
+        SharedArray<std::atomic<std::uint32_t>> shared(1);
+        auto child = [&shared] { shared[0].store(42); };
+        RunInChild(child);
+        Expect(shared[0].load()).ToEqual(std::uint32_t{42});
+    }
+
+    void TestBatchSizerStartsWithSingleTests() {
+        BatchSizer sizer;
+        Expect(sizer.Next(1000, 4)).ToEqual(std::size_t{1});
+    }
+
+    void TestBatchSizerGroupsShortTests() {
+        using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace)
+        BatchSizer sizer;
+        sizer.Observe(100ns);
+        Expect(sizer.Next(1000, 4)).ToEqual(BatchSizer::kMaxBatch);
+        // A fair share of what is left caps the batch near the end of a run.
+        Expect(sizer.Next(40, 4)).ToEqual(std::size_t{5});
+        Expect(sizer.Next(3, 4)).ToEqual(std::size_t{1});
+    }
+
+    void TestBatchSizerKeepsSlowTestsSingle() {
+        using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace)
+        BatchSizer sizer;
+        sizer.Observe(100us);
+        Expect(sizer.Next(1000, 4)).ToEqual(std::size_t{5});
+        for (int i = 0; i < 20; ++i) {
+            sizer.Observe(10ms);
+        }
+        Expect(sizer.Next(1000, 4)).ToEqual(std::size_t{1});
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "WorkQueueSuite",
+                 {
+                     {"TestPushClaimFifo", &WorkQueueSuite::TestPushClaimFifo},
+                     {"TestClaimBatch", &WorkQueueSuite::TestClaimBatch},
+                     {"TestFullQueueRejectsPush", &WorkQueueSuite::TestFullQueueRejectsPush},
+                     {"TestWrapAround", &WorkQueueSuite::TestWrapAround},
+                     {"TestSharedAcrossFork", &WorkQueueSuite::TestSharedAcrossFork},
+                     {"TestBatchSizerStartsWithSingleTests",
+                      &WorkQueueSuite::TestBatchSizerStartsWithSingleTests},
+                     {"TestBatchSizerGroupsShortTests",
+                      &WorkQueueSuite::TestBatchSizerGroupsShortTests},
+                     {"TestBatchSizerKeepsSlowTestsSingle",
+                      &WorkQueueSuite::TestBatchSizerKeepsSlowTestsSingle},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace work_queue_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    WorkQueueSuite::Register(r);
+}
+}  // namespace work_queue_test
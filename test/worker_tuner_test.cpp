@@ -0,0 +1,107 @@
+#include "flul/test/worker_tuner.hpp"
+
+#include <cstddef>
+
+#include "flul/test/expect.hpp"
+#include "flul/test/registry.hpp"
+
+using flul::test::CpuTimes;
+using flul::test::Expect;
+using flul::test::Observation;
+using flul::test::ReadCpuTimes;
+using flul::test::Registry;
+using flul::test::Suite;
+using flul::test::Utilization;
+using flul::test::WorkerTuner;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+class WorkerTunerSuite : public Suite<WorkerTunerSuite> {
+   public:
+    void TestGrowsWhileCpuIdle() {
+        WorkerTuner tuner(4, 1, 32, 4);
+        auto decision = tuner.Update({.throughput = 100, .cpu = 0.3, .load = 1.0});
+        Expect(decision.workers).ToEqual(std::size_t{5});
+        Expect(decision.reason.empty()).ToBeFalse();
+    }
+
+    void TestKeepsGrowingWhileThroughputRises() {
+        WorkerTuner tuner(8, 1, 32, 4);
+        tuner.Update({.throughput = 100, .cpu = 0.5, .load = 1.0});  // 8 -> 10
+        auto decision = tuner.Update({.throughput = 150, .cpu = 0.95, .load = 4.0});
+        Expect(decision.workers).ToEqual(std::size_t{12});
+    }
+
+    void TestRevertsWhenThroughputFalls() {
+        WorkerTuner tuner(8, 1, 32, 4);
+        tuner.Update({.throughput = 100, .cpu = 0.5, .load = 1.0});  // 8 -> 10
+        auto decision = tuner.Update({.throughput = 70, .cpu = 0.95, .load = 4.0});
+        Expect(decision.workers).ToEqual(std::size_t{8});
+        // The reverted count is left alone for a few intervals.
+        decision = tuner.Update({.throughput = 100, .cpu = 0.5, .load = 1.0});
+        Expect(decision.workers).ToEqual(std::size_t{8});
+        Expect(decision.reason.empty()).ToBeTrue();
+    }
+
+    void TestShrinksWhenOverloaded() {
+        WorkerTuner tuner(16, 1, 32, 4);
+        auto decision = tuner.Update({.throughput = 100, .cpu = 1.0, .load = 12.0});
+        Expect(decision.workers).ToEqual(std::size_t{12});
+    }
+
+    void TestHoldsWhenSaturated() {
+        WorkerTuner tuner(4, 1, 32, 4);
+        auto decision = tuner.Update({.throughput = 100, .cpu = 0.97, .load = 4.0});
+        Expect(decision.workers).ToEqual(std::size_t{4});
+        Expect(decision.reason.empty()).ToBeTrue();
+    }
+
+    void TestProbesAfterQuietIntervals() {
+        WorkerTuner tuner(4, 1, 32, 4);
+        Observation saturated{.throughput = 100, .cpu = 0.97, .load = 4.0};
+        for (int i = 1; i < WorkerTuner::kProbeEvery; ++i) {
+            Expect(tuner.Update(saturated).workers).ToEqual(std::size_t{4});
+        }
+        Expect(tuner.Update(saturated).workers).ToEqual(std::size_t{5});
+    }
+
+    void TestRespectsBounds() {
+        WorkerTuner tuner(2, 1, 2, 4);
+        auto decision = tuner.Update({.throughput = 100, .cpu = 0.1, .load = 0.0});
+        Expect(decision.workers).ToEqual(std::size_t{2});
+    }
+
+    void TestUtilization() {
+        Expect(Utilization(CpuTimes{.busy = 10, .total = 100}, CpuTimes{.busy = 60, .total = 200}))
+            .ToEqual(0.5);
+        Expect(Utilization(CpuTimes{}, CpuTimes{})).ToEqual(0.0);
+#if defined(__linux__)
+        Expect(ReadCpuTimes().has_value()).ToBeTrue();
+#endif
+    }
+
+    static void Register(Registry& r) {
+        AddTests(r, "WorkerTunerSuite",
+                 {
+                     {"TestGrowsWhileCpuIdle", &WorkerTunerSuite::TestGrowsWhileCpuIdle},
+                     {"TestKeepsGrowingWhileThroughputRises",
+                      &WorkerTunerSuite::TestKeepsGrowingWhileThroughputRises},
+                     {"TestRevertsWhenThroughputFalls",
+                      &WorkerTunerSuite::TestRevertsWhenThroughputFalls},
+                     {"TestShrinksWhenOverloaded", &WorkerTunerSuite::TestShrinksWhenOverloaded},
+                     {"TestHoldsWhenSaturated", &WorkerTunerSuite::TestHoldsWhenSaturated},
+                     {"TestProbesAfterQuietIntervals",
+                      &WorkerTunerSuite::TestProbesAfterQuietIntervals},
+                     {"TestRespectsBounds", &WorkerTunerSuite::TestRespectsBounds},
+                     {"TestUtilization", &WorkerTunerSuite::TestUtilization},
+                 });
+    }
+};
+
+// NOLINTEND(readability-convert-member-functions-to-static,readability-make-member-function-const)
+
+namespace worker_tuner_test {
+void Register(Registry& r) {  // NOLINT(misc-use-internal-linkage)
+    WorkerTunerSuite::Register(r);
+}
+}  // namespace worker_tuner_test